@@ -0,0 +1,246 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+// Benchmarks of curve construction and queries.
+//
+// Run with `--benchmark_format=json` (or `--benchmark_out=<file> --benchmark_out_format=json`)
+// for machine-readable results.
+
+#include "plot_explicit_2d.hpp"
+#include "plot_inline_2d.hpp"
+#include "plot_min_max_tree.hpp"
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+using plot::ExplicitSingleValueCurve2D;
+using plot::MinMax;
+using plot::MinMaxTree;
+
+namespace {
+
+/// Number of values of the curves queried by the query benchmarks.
+constexpr size_t QUERY_NUM_VALUES = size_t{1} << 22;
+
+/// Number of queries prepared in advance for each query benchmark.
+constexpr size_t NUM_PREPARED_QUERIES = 1 << 16;
+
+struct CurveValues
+{
+    std::shared_ptr<std::vector<double>> x_values;
+    std::shared_ptr<std::vector<std::optional<double>>> y_values;
+};
+
+/// Returns `num_values` values at X = 0, 1, 2, ...; a `empty_fraction` of the Y values (chosen at random) is empty.
+///
+/// The values are generated once for each set of arguments.
+///
+const CurveValues& GetCurveValues(size_t num_values, double empty_fraction)
+{
+    static std::map<std::pair<size_t, double>, CurveValues> cache;
+
+    auto& values = cache[{num_values, empty_fraction}];
+    if (!values.x_values)
+    {
+        std::mt19937_64 rng(num_values);
+        std::uniform_real_distribution<double> value_distr(-1.0, 1.0);
+        std::bernoulli_distribution empty_distr(empty_fraction);
+
+        values.x_values = std::make_shared<std::vector<double>>(num_values);
+        values.y_values = std::make_shared<std::vector<std::optional<double>>>(num_values);
+        for (size_t i = 0; i < num_values; ++i)
+        {
+            (*values.x_values)[i] = static_cast<double>(i);
+            if (!empty_distr(rng)) { (*values.y_values)[i] = value_distr(rng); }
+        }
+    }
+
+    return values;
+}
+
+/// Returns `NUM_PREPARED_QUERIES` intervals [xmin, xmax] of widths up to `max_width` within [0, `num_values` - 1].
+std::vector<std::pair<double, double>> MakeQueries(size_t num_values, double max_width)
+{
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> width_distr(0.0, max_width);
+
+    std::vector<std::pair<double, double>> queries;
+    for (size_t i = 0; i < NUM_PREPARED_QUERIES; ++i)
+    {
+        const double width = width_distr(rng);
+        const double xmin = std::uniform_real_distribution<double>(0.0, num_values - 1 - width)(rng);
+        queries.emplace_back(xmin, xmin + width);
+    }
+
+    return queries;
+}
+
+// ---------------------------- Construction -----------------------------------------
+
+void BM_Construction(benchmark::State& state)
+{
+    const size_t num_values = state.range(0);
+    const CurveValues& values = GetCurveValues(num_values, 0.0);
+
+    size_t num_tree_nodes = 0;
+    for (auto _: state)
+    {
+        ExplicitSingleValueCurve2D curve(values.x_values, values.y_values);
+        num_tree_nodes = curve.GetTree().GetNumNodes();
+        benchmark::DoNotOptimize(curve);
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_values);
+    state.counters["tree_bytes_per_value"] = static_cast<double>(num_tree_nodes * 2 * sizeof(double)) / num_values;
+}
+BENCHMARK(BM_Construction)->RangeMultiplier(10)->Range(1000, PLOT_BENCH_MAX_VALUES)->Unit(benchmark::kMillisecond);
+
+// ---------------------------- Queries ----------------------------------------------
+
+void RunQueries(benchmark::State& state, double empty_fraction, double max_width, const plot::BuildOptions& options = {})
+{
+    const CurveValues& values = GetCurveValues(QUERY_NUM_VALUES, empty_fraction);
+    const ExplicitSingleValueCurve2D curve(values.x_values, values.y_values, options);
+    const auto queries = MakeQueries(QUERY_NUM_VALUES, max_width);
+
+    size_t i = 0;
+    for (auto _: state)
+    {
+        const auto& [xmin, xmax] = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(curve.GetMinMaxOverDomainInterval(xmin, xmax));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_QueryNarrow(benchmark::State& state) { RunQueries(state, 0.0, 64.0); }
+BENCHMARK(BM_QueryNarrow);
+
+void BM_QueryWide(benchmark::State& state) { RunQueries(state, 0.0, QUERY_NUM_VALUES - 1); }
+BENCHMARK(BM_QueryWide);
+
+/// Narrow queries of a curve with an `XIndex`.
+void BM_QueryNarrowIndexed(benchmark::State& state)
+{
+    plot::BuildOptions options;
+    options.build_x_index = true;
+    RunQueries(state, 0.0, 64.0, options);
+}
+BENCHMARK(BM_QueryNarrowIndexed);
+
+/// Narrow queries of the header-only curve, which are inlined into the benchmark loop.
+void BM_QueryNarrowInline(benchmark::State& state)
+{
+    const CurveValues& values = GetCurveValues(QUERY_NUM_VALUES, 0.0);
+    const plot::InlineExplicitCurve2D<double, 2> curve(values.x_values, values.y_values);
+    const auto queries = MakeQueries(QUERY_NUM_VALUES, 64.0);
+
+    size_t i = 0;
+    for (auto _: state)
+    {
+        const auto& [xmin, xmax] = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(curve.GetMinMaxOverDomainInterval(xmin, xmax));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueryNarrowInline);
+
+/// Narrow queries panning across the curve, passing a `SearchHint` between them.
+void BM_QueryPanned(benchmark::State& state)
+{
+    const CurveValues& values = GetCurveValues(QUERY_NUM_VALUES, 0.0);
+    const ExplicitSingleValueCurve2D curve(values.x_values, values.y_values);
+
+    plot::SearchHint hint;
+    double xmin = 0.0;
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(curve.GetMinMaxOverDomainInterval(xmin, xmin + 64.0, hint));
+        xmin += 3.5;
+        if (xmin > QUERY_NUM_VALUES - 65) { xmin = 0.0; }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueryPanned);
+
+/// Queries of a curve with 90% of Y values empty.
+void BM_QuerySparse(benchmark::State& state) { RunQueries(state, 0.9, 4096.0); }
+BENCHMARK(BM_QuerySparse);
+
+/// Column queries spanning the whole curve; the argument is the number of columns.
+void BM_Columns(benchmark::State& state)
+{
+    const CurveValues& values = GetCurveValues(QUERY_NUM_VALUES, 0.0);
+    const ExplicitSingleValueCurve2D curve(values.x_values, values.y_values);
+    const size_t num_columns = state.range(0);
+
+    std::vector<std::optional<std::tuple<double, double>>> output;
+    for (auto _: state)
+    {
+        curve.GetMinMaxOverDomainColumns(0.0, QUERY_NUM_VALUES - 1, num_columns, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_columns);
+}
+BENCHMARK(BM_Columns)->Arg(256)->Arg(1920)->Arg(7680);
+
+// ---------------------------- Tree -------------------------------------------------
+
+/// Compares the iterative and the recursive `MinMaxTree` query; the argument is the max. query width in leaves.
+template<bool RECURSIVE>
+void BM_TreeQuery(benchmark::State& state)
+{
+    static const MinMaxTree tree = [] {
+        std::mt19937_64 rng(1);
+        std::uniform_real_distribution<double> value_distr(-1.0, 1.0);
+
+        MinMaxTree result(QUERY_NUM_VALUES);
+        for (size_t i = 0; i < QUERY_NUM_VALUES; ++i)
+        {
+            const double value = value_distr(rng);
+            result.SetLeaf(i, {value, value});
+        }
+        result.FillInternalNodes();
+        return result;
+    }();
+
+    const size_t max_width = state.range(0);
+    std::mt19937_64 rng(2);
+    std::vector<std::pair<size_t, size_t>> queries;
+    for (size_t i = 0; i < NUM_PREPARED_QUERIES; ++i)
+    {
+        const size_t width = std::uniform_int_distribution<size_t>(1, max_width)(rng);
+        const size_t first = std::uniform_int_distribution<size_t>(0, QUERY_NUM_VALUES - width)(rng);
+        queries.emplace_back(first, first + width - 1);
+    }
+
+    size_t i = 0;
+    for (auto _: state)
+    {
+        const auto& [first, last] = queries[i++ % queries.size()];
+        const MinMax result = RECURSIVE
+            ? tree.GetMinMaxOverLeafIntervalRecursive(first, last)
+            : tree.GetMinMaxOverLeafInterval(first, last);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_TreeQuery, false)->Arg(64)->Arg(QUERY_NUM_VALUES);
+BENCHMARK_TEMPLATE(BM_TreeQuery, true)->Arg(64)->Arg(QUERY_NUM_VALUES);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,123 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_AGGREGATE_2D_H
+#define PLOT_AGGREGATE_2D_H
+
+#include "plot_min_max_tree.hpp"
+#include "plot_value_tree.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace plot {
+
+/// Min, max, sum, count, first and last of the non-empty values of an interval (see `FullAggregation`).
+struct Aggregate
+{
+    double min;
+    double max;
+    double sum;
+    size_t count; ///< Number of non-empty values.
+    double first; ///< First non-empty value; unspecified if `count` is 0.
+    double last;  ///< Last non-empty value; unspecified if `count` is 0.
+
+    bool IsEmpty() const { return count == 0; }
+
+    double GetMean() const { return sum / static_cast<double>(count); }
+};
+
+/// Explicit single-value 2D curve: y = f(x); finds aggregates (see `Aggregate`) of Y values over an interval
+/// in O(log n), in the same descent of the tree.
+///
+/// @tparam T Type of the stored Y values: `double`, `float`, `int32_t` or `int16_t`.
+/// @tparam Aggregation `FullAggregation` or `MinMaxAggregation` (see `BasicMinMaxTree`); instantiated
+///     in "plot_aggregate_2d.cpp". The Y values are stored in a `BasicValueTree`, as in
+///     `BasicExplicitSingleValueCurve2D`; with `MinMaxAggregation`, the tree is the same as that curve's.
+///
+/// Unlike the min and max queries of the other curves, aggregates cover only the stored values
+/// (nothing is interpolated at the ends of intervals), since sums and counts of interpolated values
+/// would be meaningless.
+///
+template<typename T, typename Aggregation = FullAggregation>
+class BasicAggregateCurve2D
+{
+public:
+    /// Result of the queries: `Aggregate` for `FullAggregation`, `MinMax` for `MinMaxAggregation`.
+    using Result = std::conditional_t<Aggregation::HAS_EXTRA, Aggregate, MinMax>;
+
+    /// Constructor.
+    ///
+    /// @param x_values X values; must be strictly increasing. May be empty (e.g. for a curve to be filled with `Append()`).
+    /// @param y_values Y values corresponding to `x_values`.
+    /// @param options Build options; also used when the tree is rebuilt after appending values.
+    ///
+    BasicAggregateCurve2D(
+        std::shared_ptr<std::vector<double>> x_values,
+        std::shared_ptr<std::vector<std::optional<T>>> y_values,
+        const BuildOptions& options = {}
+    );
+
+    size_t GetNumValues() const { return x_values_->size(); }
+
+    /// Returns the aggregate of values [lo_idx, hi_idx].
+    Result GetAggregateOverIndexInterval(size_t lo_idx, size_t hi_idx) const;
+
+    /// Returns the aggregate of the Y values whose X values are in [xmin, xmax].
+    Result GetAggregateOverDomainInterval(double xmin, double xmax) const;
+
+    /// Returns the aggregate of Y values for each of `num_columns` equal-width columns spanning [xmin, xmax].
+    ///
+    /// @param output Receives `num_columns` elements; element [i] corresponds to the column
+    ///     [xmin + i * w, xmin + (i + 1) * w), where w = (xmax - xmin) / num_columns; the last column also
+    ///     includes `xmax`. Columns are half-open, so that each value is counted once.
+    ///
+    void GetAggregateOverDomainColumns(double xmin, double xmax, size_t num_columns, std::vector<Result>& output) const;
+
+    /// Appends a value to the curve (and to the vectors passed to the constructor); runs in amortized O(log n).
+    ///
+    /// @param x Must be greater than the last X value.
+    ///
+    void Append(double x, const std::optional<T>& y);
+
+    /// Replaces the Y value at `idx` (in the vector passed to the constructor); runs in O(log n).
+    void SetValue(size_t idx, const std::optional<T>& y) { y_values_.SetValue(idx, y); }
+
+    const std::vector<double>& GetXValues() const { return *x_values_; }
+    const std::vector<std::optional<T>>& GetYValues() const { return y_values_.GetValues(); }
+
+    const BasicMinMaxTree<T, Aggregation>& GetTree() const { return y_values_.GetTree(); }
+
+    /// See `BasicValueTree::GetVersion()`.
+    size_t GetVersion() const { return y_values_.GetVersion(); }
+
+    /// See `BasicValueTree::GetId()`.
+    size_t GetId() const { return y_values_.GetId(); }
+
+private:
+    /// Provides the X values to the searches of "plot_domain_query.hpp".
+    struct ValueAccess;
+
+    /// Returns the aggregate of values [begin_idx, end_idx).
+    Result GetAggregateOverBounds(size_t begin_idx, size_t end_idx) const;
+
+    std::shared_ptr<std::vector<double>> x_values_;
+
+    BasicValueTree<T, Aggregation> y_values_;
+};
+
+using AggregateCurve2D = BasicAggregateCurve2D<double>;
+
+} // namespace plot
+
+#endif // PLOT_AGGREGATE_2D_H
@@ -0,0 +1,103 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_ASYNC_BUILD_H
+#define PLOT_ASYNC_BUILD_H
+
+#include "plot_value_tree.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace plot {
+
+/// Handle of a curve being built in the background; see `BuildAsync()`.
+template<typename Curve>
+class AsyncBuild
+{
+public:
+    AsyncBuild(std::shared_ptr<std::atomic<bool>> cancel, std::future<Curve> future)
+    : cancel_(std::move(cancel)), future_(std::move(future))
+    {}
+
+    /// Requests cancellation: the build stops at its next check and `Get()` throws `BuildCancelled`
+    /// (unless the build has already finished).
+    void Cancel() { cancel_->store(true, std::memory_order_relaxed); }
+
+    bool IsReady() const { return future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+    void Wait() const { future_.wait(); }
+
+    /// Waits for the build and returns the curve; rethrows the build's exception (e.g. `BuildCancelled`).
+    ///
+    /// May be called once.
+    ///
+    Curve Get() { return future_.get(); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancel_;
+
+    std::future<Curve> future_;
+};
+
+/// Builds a curve by a task run on `executor` (e.g. a thread pool), so that the calling thread does not wait.
+///
+/// @param make_curve Called as `make_curve(options)` (with `BuildOptions::cancel` set to the returned handle's flag)
+///     to construct the curve, e.g. `[=](const BuildOptions& o) { return ExplicitSingleValueCurve2D(x, y, o); }`.
+///     Everything it refers to must remain valid until the build finishes.
+/// @param executor Called once as `executor(task)` with a `std::function<void()>`, which it has to run
+///     on any thread.
+///
+template<typename MakeCurve, typename Executor>
+auto BuildAsync(MakeCurve make_curve, BuildOptions options, Executor&& executor)
+    -> AsyncBuild<std::invoke_result_t<MakeCurve, const BuildOptions&>>
+{
+    using Curve = std::invoke_result_t<MakeCurve, const BuildOptions&>;
+
+    // shared with the task, so that it outlives the handle if the build is still running
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    options.cancel = cancel.get();
+
+    auto task = std::make_shared<std::packaged_task<Curve()>>(
+        [make_curve = std::move(make_curve), options, cancel] { return make_curve(options); }
+    );
+    AsyncBuild<Curve> handle(cancel, task->get_future());
+
+    executor(std::function<void()>([task] { (*task)(); }));
+
+    return handle;
+}
+
+/// Same as `BuildAsync(make_curve, options, executor)`, but builds the curve on a new thread.
+///
+/// Destroying the handle waits for the build to finish (call `AsyncBuild::Cancel()` first to stop it early).
+///
+template<typename MakeCurve>
+auto BuildAsync(MakeCurve make_curve, BuildOptions options = {}) -> AsyncBuild<std::invoke_result_t<MakeCurve, const BuildOptions&>>
+{
+    using Curve = std::invoke_result_t<MakeCurve, const BuildOptions&>;
+
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    options.cancel = cancel.get();
+
+    return AsyncBuild<Curve>(
+        cancel,
+        std::async(std::launch::async, [make_curve = std::move(make_curve), options, cancel] { return make_curve(options); })
+    );
+}
+
+} // namespace plot
+
+#endif // PLOT_ASYNC_BUILD_H
@@ -0,0 +1,126 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_COLUMN_CACHE_H
+#define PLOT_COLUMN_CACHE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace plot {
+
+/// Caches the min and max values of grid-aligned columns of a curve between consecutive queries
+/// (e.g. frames of a panned view).
+///
+/// Column `k` spans [k * column_width, (k + 1) * column_width]. When a query has the same curve (compared by
+/// `GetId()` of the curve types, since a new curve may be created at the address of a destroyed one), column width
+/// and curve version (see `GetVersion()`) as the previous one, only the columns not returned by the previous query
+/// are computed; panning by d columns costs O(d log n) instead of O(W log n).
+///
+/// @tparam Curve A curve type providing `GetId()`, `GetVersion()` and `GetMinMaxOverDomainColumns(column_edges, output)`.
+///
+template<typename Curve>
+class ColumnCache
+{
+public:
+    using Results = std::vector<std::optional<std::tuple<double, double>>>;
+
+    /// Returns the min and max Y value for columns [first_column, first_column + num_columns) of `curve`.
+    ///
+    /// The result is the same as `curve.GetMinMaxOverDomainColumns()` for column edges k * `column_width`.
+    ///
+    const Results& GetColumns(const Curve& curve, double column_width, int64_t first_column, size_t num_columns)
+    {
+        const int64_t end_column = first_column + static_cast<int64_t>(num_columns);
+
+        size_t num_reused = 0;
+        if (curve_id_ == curve.GetId() && column_width_ == column_width && version_ == curve.GetVersion())
+        {
+            const int64_t reused_first = std::max(first_column, first_column_);
+            const int64_t reused_end = std::min(end_column, first_column_ + static_cast<int64_t>(columns_.size()));
+
+            if (reused_first < reused_end)
+            {
+                std::swap(columns_, previous_columns_);
+                columns_.assign(num_columns, std::nullopt);
+                std::copy(
+                    previous_columns_.begin() + (reused_first - first_column_),
+                    previous_columns_.begin() + (reused_end - first_column_),
+                    columns_.begin() + (reused_first - first_column)
+                );
+                num_reused = reused_end - reused_first;
+
+                ComputeColumns(curve, column_width, first_column, reused_first, first_column);
+                ComputeColumns(curve, column_width, reused_end, end_column, first_column);
+            }
+        }
+
+        if (num_reused == 0)
+        {
+            columns_.assign(num_columns, std::nullopt);
+            ComputeColumns(curve, column_width, first_column, end_column, first_column);
+        }
+
+        num_computed_ = num_columns - num_reused;
+        curve_id_ = curve.GetId();
+        column_width_ = column_width;
+        first_column_ = first_column;
+        version_ = curve.GetVersion();
+
+        return columns_;
+    }
+
+    /// Returns the number of columns computed (not reused) by the last call to `GetColumns()`.
+    size_t GetNumComputedColumns() const { return num_computed_; }
+
+    /// Discards the cached results.
+    void Clear()
+    {
+        curve_id_ = std::nullopt;
+        columns_.clear();
+    }
+
+private:
+    /// Computes columns [begin_column, end_column) into `columns_`, which starts at `first_column`.
+    void ComputeColumns(const Curve& curve, double column_width, int64_t begin_column, int64_t end_column, int64_t first_column)
+    {
+        if (begin_column >= end_column) { return; }
+
+        edges_.clear();
+        for (int64_t k = begin_column; k <= end_column; ++k)
+        {
+            edges_.push_back(static_cast<double>(k) * column_width);
+        }
+
+        curve.GetMinMaxOverDomainColumns(edges_, computed_);
+        std::copy(computed_.begin(), computed_.end(), columns_.begin() + (begin_column - first_column));
+    }
+
+    std::optional<size_t> curve_id_;
+    double column_width_{0};
+    int64_t first_column_{0};
+    size_t version_{0};
+
+    Results columns_;
+    size_t num_computed_{0};
+
+    // reused between calls to avoid allocations
+    Results previous_columns_;
+    std::vector<double> edges_;
+    Results computed_;
+};
+
+} // namespace plot
+
+#endif // PLOT_COLUMN_CACHE_H
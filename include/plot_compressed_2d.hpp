@@ -0,0 +1,111 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_COMPRESSED_2D_H
+#define PLOT_COMPRESSED_2D_H
+
+#include "plot_min_max_tree.hpp"
+#include "plot_value_tree.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace plot {
+
+/// Explicit single-value 2D curve: y = f(x), with the Y values stored compressed.
+///
+/// Y values are split into blocks, and each block is encoded separately with XOR compression (as in Gorilla,
+/// Pelkonen et al. 2015): a value equal to the previous one takes 1 bit, and a value differing only in a few
+/// mantissa bits takes little more than those bits, so smooth or slowly changing signals shrink several times.
+///
+/// Each block is one leaf of the tree, so the leaves act as the blocks' min and max headers: a query decodes
+/// only the (at most two) blocks partially covered by its interval, and reads the rest from the tree.
+///
+class CompressedExplicitSingleValueCurve2D
+{
+public:
+    /// Constructor.
+    ///
+    /// @param x_values X values; must be strictly increasing.
+    /// @param y_values Y values corresponding to `x_values`; compressed, not retained. NaN values are treated as missing.
+    /// @param block_size Number of values per block (and tree leaf); must be a power of 2. Larger blocks compress
+    ///     better (the first value of each block is stored uncompressed), but make the queries decode more values.
+    /// @param options Build options (`leaf_size`, `build_x_index` and `lazy` are ignored).
+    ///
+    CompressedExplicitSingleValueCurve2D(
+        std::shared_ptr<std::vector<double>> x_values,
+        const std::vector<std::optional<double>>& y_values,
+        size_t block_size = 128,
+        const BuildOptions& options = {}
+    );
+
+    size_t GetNumValues() const { return x_values_->size(); }
+
+    /// Returns the Y value at `idx`; decodes its block up to `idx`.
+    std::optional<double> GetY(size_t idx) const;
+
+    /// Returns the size of the compressed Y values in bytes (not including the tree).
+    size_t GetCompressedSize() const { return bits_.size() * sizeof(uint64_t) + block_offsets_.size() * sizeof(size_t); }
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval()`.
+    std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(double xmin, double xmax) const;
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`.
+    void GetMinMaxOverDomainColumns(
+        double xmin,
+        double xmax,
+        size_t num_columns,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`.
+    void GetMinMaxOverDomainColumns(
+        const std::vector<double>& column_edges,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+    const std::vector<double>& GetXValues() const { return *x_values_; }
+
+    /// Returns the tree of min and max values of the blocks.
+    const MinMaxTree& GetTree() const { return tree_; }
+
+private:
+    /// Provides the curve's values to the domain queries (see "plot_domain_query.hpp").
+    struct ValueAccess;
+
+    /// Decodes values of one block from its start until `end_idx`, calling `func(idx, value)` for those
+    /// from `begin_idx` on (missing values are NaN).
+    template<typename Func>
+    void DecodeBlock(size_t begin_idx, size_t end_idx, Func func) const;
+
+    /// Returns the min and max of non-missing Y values in [begin_idx, end_idx), which are within one block.
+    MinMax ScanBlock(size_t begin_idx, size_t end_idx) const;
+
+    std::shared_ptr<std::vector<double>> x_values_;
+
+    size_t block_size_;
+
+    /// Encoded blocks, most significant bit first.
+    std::vector<uint64_t> bits_;
+
+    /// Bit offset in `bits_` of each block.
+    std::vector<size_t> block_offsets_;
+
+    /// Min and max values of the blocks.
+    MinMaxTree tree_;
+};
+
+} // namespace plot
+
+#endif // PLOT_COMPRESSED_2D_H
@@ -0,0 +1,119 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_CONCURRENT_2D_H
+#define PLOT_CONCURRENT_2D_H
+
+#include "plot_min_max_tree.hpp"
+#include "plot_value_tree.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace plot {
+
+/// Explicit single-value 2D curve which is appended to by one thread and queried concurrently by any number of threads.
+///
+/// Queries never block and never wait for the writer; each query sees the values published up to some point
+/// (at least those published before the query started).
+///
+/// Values are only appended, so a query over the first n published values reads only tree nodes spanning
+/// complete leaves of those values, none of which are modified by subsequent appends. When the capacity
+/// is exceeded, the writer builds new buffers and publishes them atomically; the old buffers may still be
+/// read by running queries and are released when the curve is destroyed (the capacity grows geometrically,
+/// so they take at most as much memory as the current ones).
+///
+/// @tparam T See `BasicExplicitSingleValueCurve2D`.
+///
+template<typename T>
+class BasicConcurrentExplicitSingleValueCurve2D
+{
+public:
+    /// Constructor; creates an empty curve.
+    ///
+    /// @param options Build options; used whenever the buffers are rebuilt.
+    /// @param initial_capacity Number of values that can be appended before the first rebuild.
+    ///
+    explicit BasicConcurrentExplicitSingleValueCurve2D(const BuildOptions& options = {}, size_t initial_capacity = 0);
+
+    BasicConcurrentExplicitSingleValueCurve2D(const BasicConcurrentExplicitSingleValueCurve2D&) = delete;
+    BasicConcurrentExplicitSingleValueCurve2D& operator=(const BasicConcurrentExplicitSingleValueCurve2D&) = delete;
+
+    /// Appends a value and publishes it to queries; must be called by one thread at a time.
+    ///
+    /// @param x Must be greater than the last X value.
+    ///
+    /// Runs in amortized O(log n).
+    ///
+    void Append(double x, const std::optional<T>& y);
+
+    /// Returns the number of published values; may be called from any thread.
+    size_t GetNumValues() const;
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval()`; may be called from any thread.
+    std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(double xmin, double xmax) const;
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`; may be called from any thread.
+    void GetMinMaxOverDomainColumns(
+        double xmin,
+        double xmax,
+        size_t num_columns,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`; may be called from any thread.
+    void GetMinMaxOverDomainColumns(
+        const std::vector<double>& column_edges,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+    /// See `ExplicitSingleValueCurve2D::GetEnvelope()`; may be called from any thread.
+    void GetEnvelope(double xmin, double xmax, size_t width, std::vector<EnvelopePoint>& output) const;
+
+private:
+    /// Values and their tree; only the values [0, num_values) are accessed by queries.
+    struct Buffers
+    {
+        size_t capacity;
+        std::unique_ptr<double[]> x_values;
+        std::unique_ptr<std::optional<T>[]> y_values;
+        BasicMinMaxTree<T> tree;
+
+        /// Number of published values; stored by the writer with release semantics after writing them.
+        std::atomic<size_t> num_values{0};
+    };
+
+    /// Provides the values published in a `Buffers` to the domain queries (see "plot_domain_query.hpp").
+    struct ValueAccess;
+
+    /// Returns the values published so far.
+    ValueAccess GetPublishedValues() const;
+
+    /// Replaces the current buffers with ones of at least `capacity` values.
+    void Grow(size_t capacity);
+
+    BuildOptions options_;
+
+    /// Current buffers followed by the retired ones; accessed only by the writer.
+    std::vector<std::unique_ptr<Buffers>> buffers_;
+
+    /// Buffers read by queries.
+    std::atomic<const Buffers*> current_{nullptr};
+};
+
+using ConcurrentExplicitSingleValueCurve2D = BasicConcurrentExplicitSingleValueCurve2D<double>;
+
+} // namespace plot
+
+#endif // PLOT_CONCURRENT_2D_H
@@ -0,0 +1,117 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_CURVE_BUILDER_H
+#define PLOT_CURVE_BUILDER_H
+
+#include "plot_explicit_2d.hpp"
+#include "plot_value_tree.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace plot {
+
+/// What `BasicExplicitCurveBuilder` does with values having equal X.
+enum class DuplicateX
+{
+    Reject,     ///< `Build()` throws `InvalidCurveData`.
+    KeepFirst,  ///< The value added first (in chunk order, then in order within the chunk) is kept.
+    KeepLast    ///< The value added last is kept.
+};
+
+/// Thrown by `BasicExplicitCurveBuilder` for input which does not form a valid curve.
+class InvalidCurveData: public std::runtime_error
+{
+public:
+    InvalidCurveData(const std::string& reason, size_t chunk_idx, size_t value_idx)
+    : std::runtime_error(
+        "invalid curve data: " + reason + " (chunk " + std::to_string(chunk_idx) + ", value " + std::to_string(value_idx) + ")"
+    ), chunk_idx_(chunk_idx), value_idx_(value_idx)
+    {}
+
+    /// Index of the offending chunk, in the order of `AddChunk()` calls.
+    size_t GetChunkIndex() const { return chunk_idx_; }
+
+    /// Index of the offending value within its chunk.
+    size_t GetValueIndex() const { return value_idx_; }
+
+private:
+    size_t chunk_idx_;
+    size_t value_idx_;
+};
+
+/// Builds a `BasicExplicitSingleValueCurve2D` from chunks of values (e.g. read from separate files or by separate threads),
+/// which need not be sorted by X or be disjoint.
+///
+/// The chunks are validated (and sorted if needed) in parallel, and written directly into the vectors passed to the curve;
+/// a single chunk which is already strictly increasing is passed to the curve without copying. Chunks which do not overlap
+/// are copied in parallel, overlapping ones are merged by one thread. Sorting a chunk does not move its values, but creates
+/// an array of indices (a `size_t` per value).
+///
+/// Unlike the curve's constructor, which aborts on invalid X values, `Build()` reports them by throwing `InvalidCurveData`.
+///
+template<typename T>
+class BasicExplicitCurveBuilder
+{
+public:
+    explicit BasicExplicitCurveBuilder(DuplicateX duplicates = DuplicateX::Reject): duplicates_(duplicates) {}
+
+    /// Adds a chunk of values; they may be in any order.
+    ///
+    /// @param x_values X values; must be finite.
+    /// @param y_values Y values corresponding to `x_values`.
+    ///
+    /// @throws InvalidCurveData if the vectors have different sizes.
+    ///
+    void AddChunk(std::vector<double> x_values, std::vector<std::optional<T>> y_values);
+
+    size_t GetNumChunks() const { return chunks_.size(); }
+
+    /// Builds the curve from the added chunks; the builder is left empty (also if an exception is thrown).
+    ///
+    /// @param options Passed to the curve (also used for the number of threads validating and sorting the chunks).
+    ///
+    /// @throws InvalidCurveData if an X value is not finite, or if X values repeat and duplicates are rejected.
+    ///
+    BasicExplicitSingleValueCurve2D<T> Build(const BuildOptions& options = {});
+
+private:
+    struct Chunk
+    {
+        std::vector<double> x_values;
+        std::vector<std::optional<T>> y_values;
+
+        /// If not empty, indices of the values to use, in the order of increasing X (without duplicates);
+        /// otherwise all values are used in their order.
+        std::vector<size_t> order;
+
+        size_t GetSize() const { return order.empty() ? x_values.size() : order.size(); }
+
+        /// Returns the index (in `x_values` and `y_values`) of the `i`-th value in the order of increasing X.
+        size_t GetIndex(size_t i) const { return order.empty() ? i : order[i]; }
+    };
+
+    /// Checks the chunk's X values and sets its `order`; returns the error, if any.
+    static std::optional<InvalidCurveData> PrepareChunk(Chunk& chunk, size_t chunk_idx, DuplicateX duplicates);
+
+    DuplicateX duplicates_;
+
+    std::vector<Chunk> chunks_;
+};
+
+using ExplicitCurveBuilder = BasicExplicitCurveBuilder<double>;
+
+} // namespace plot
+
+#endif // PLOT_CURVE_BUILDER_H
@@ -0,0 +1,112 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_CURVE_FILE_H
+#define PLOT_CURVE_FILE_H
+
+#include "plot_explicit_2d.hpp"
+#include "plot_min_max_tree.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace plot {
+
+// Curve file format
+// -----------------
+//
+// All values are stored in the byte order of the machine which wrote the file; the header's byte order mark
+// lets readers reject files of a different byte order (values are used in place, without conversion).
+// Each section starts at an offset which is a multiple of 64.
+//
+//   header:
+//     char     magic[8]            "PLOTCRV\0"
+//     uint32   version             CURVE_FILE_VERSION
+//     uint32   byte_order_mark     0x01020304
+//     uint64   num_values          N
+//     uint64   leaf_size           B; number of values per tree leaf (a power of 2)
+//     uint64   num_leaves          L; a power of 2, L * B >= N
+//     uint64   x_offset            offset of N doubles: X values (strictly increasing)
+//     uint64   y_offset            offset of N doubles: Y values (unspecified where empty)
+//     uint64   validity_offset     offset of ceil(N/8) bytes: bit i%8 of byte i/8 is set if Y value i is not empty
+//     uint64   tree_min_offset     offset of 2L-1 doubles: min values of the tree nodes (see `MinMaxTree`)
+//     uint64   tree_max_offset     offset of 2L-1 doubles: max values of the tree nodes
+//
+
+constexpr uint32_t CURVE_FILE_VERSION = 1;
+
+/// Writes `curve`, including its tree, to a curve file.
+///
+/// @throws std::runtime_error if the file cannot be written.
+///
+void WriteCurveFile(const ExplicitSingleValueCurve2D& curve, const std::string& path);
+
+/// Explicit single-value 2D curve stored in a memory-mapped curve file.
+///
+/// Queries read the values and the prebuilt tree directly from the mapped pages, so opening the file
+/// takes constant time, and the pages are shared (via the OS page cache) by all processes mapping the file.
+/// The file's contents are trusted to be consistent (only the header is validated).
+///
+class MappedExplicitSingleValueCurve2D
+{
+public:
+    /// @throws std::runtime_error if the file cannot be mapped or is not a valid curve file of this machine's byte order.
+    explicit MappedExplicitSingleValueCurve2D(const std::string& path);
+
+    ~MappedExplicitSingleValueCurve2D();
+
+    MappedExplicitSingleValueCurve2D(const MappedExplicitSingleValueCurve2D&) = delete;
+    MappedExplicitSingleValueCurve2D& operator=(const MappedExplicitSingleValueCurve2D&) = delete;
+
+    MappedExplicitSingleValueCurve2D(MappedExplicitSingleValueCurve2D&& other);
+    MappedExplicitSingleValueCurve2D& operator=(MappedExplicitSingleValueCurve2D&& other);
+
+    size_t GetNumValues() const { return num_values_; }
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval()`.
+    std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(double xmin, double xmax) const;
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`.
+    void GetMinMaxOverDomainColumns(
+        double xmin,
+        double xmax,
+        size_t num_columns,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`.
+    void GetMinMaxOverDomainColumns(
+        const std::vector<double>& column_edges,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+private:
+    /// Provides the curve's values to the domain queries (see "plot_domain_query.hpp").
+    struct ValueAccess;
+
+    void Unmap();
+
+    void* mapping_{nullptr};
+    size_t mapping_size_{0};
+
+    size_t num_values_{0};
+    size_t leaf_size_{0};
+    const double* x_values_{nullptr};
+    const double* y_values_{nullptr};
+    const uint8_t* validity_{nullptr};
+    MinMaxTreeView tree_;
+};
+
+} // namespace plot
+
+#endif // PLOT_CURVE_FILE_H
@@ -11,67 +11,187 @@
 #ifndef PLOT_H
 #define PLOT_H
 
+#include "plot_min_max_tree.hpp"
+#include "plot_value_tree.hpp"
+#include "plot_x_index.hpp"
+
 #include <optional>
 #include <tuple>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 namespace plot {
 
+template<typename T>
+class BasicExplicitCurveBuilder;
+
 /// Represents an explicit single-value 2D curve: y = f(x); finds min and max value over an interval in O(log n).
-class ExplicitSingleValueCurve2D
+///
+/// @tparam T Type of the stored Y values and of the tree's min and max values: `double`, `float`, `int32_t`
+///     or `int16_t` (instantiated in "plot_explicit_2d.cpp"). Query results and interpolated values are `double`.
+///
+template<typename T>
+class BasicExplicitSingleValueCurve2D
 {
 public:
     /// Constructor.
     ///
-    /// @param x_values X values; must be strictly increasing.
+    /// @param x_values X values; must be strictly increasing. May be empty (e.g. for a curve to be filled with `Append()`).
     /// @param y_values Y values corresponding to `x_values`.
+    /// @param options Build options; also used when the tree is rebuilt after appending values.
+    ///     With `BuildOptions::lazy`, the constructor only stores the values; see `EnsureBuilt()`.
     ///
     /// Using `shared_ptr`s to simplify working with caching (if any) of the values on the client side.
     ///
-    ExplicitSingleValueCurve2D(
+    BasicExplicitSingleValueCurve2D(
         std::shared_ptr<std::vector<double>> x_values,
-        std::shared_ptr<std::vector<std::optional<double>>> y_values
+        std::shared_ptr<std::vector<std::optional<T>>> y_values,
+        const BuildOptions& options = {}
     );
 
     /// Returns the min and max Y value in the interval [xmin, xmax];
     /// or `std::nullopt` if the interval contains no values.
     std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(double xmin, double xmax) const;
 
-    const std::vector<double>& GetXValues() const { return *x_values_; }
-    const std::vector<std::optional<double>>& GetYValues() const { return *y_values_; }
+    /// Same as `GetMinMaxOverDomainInterval(xmin, xmax)`, but starts the search for `xmin` from `hint`,
+    /// which is updated for the next query.
+    ///
+    /// For a sequence of nearby queries (e.g. a panned or zoomed view) each search is then O(log d),
+    /// where d is the number of values between the previous and the current interval.
+    ///
+    std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(double xmin, double xmax, SearchHint& hint) const;
 
-private:
-    void FillIntervals();
+    /// Returns the min and max Y value for each of `num_columns` equal-width columns spanning [xmin, xmax].
+    ///
+    /// The result is the same as calling `GetMinMaxOverDomainInterval()` for each column, but `x_values_`
+    /// are walked only once, left to right, and the interpolated value at each column edge is computed once.
+    ///
+    /// @param output Receives `num_columns` elements; element [i] corresponds to the column
+    ///     [xmin + i * w, xmin + (i + 1) * w], where w = (xmax - xmin) / num_columns.
+    ///
+    void GetMinMaxOverDomainColumns(
+        double xmin,
+        double xmax,
+        size_t num_columns,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
 
-    /// Returns the min and max value of the `y_values_` interval between indices [lo_idx, hi_idx];
-    /// or `std::nullopt` if the interval contains no values.
+    /// Returns the min and max Y value for each column delimited by `column_edges`.
     ///
-    /// @param interval_idx Index in `intervals_` of the initial interval to test.
+    /// @param column_edges Column edges; must be non-decreasing.
+    /// @param output Receives `column_edges.size() - 1` elements; element [i] corresponds to the column
+    ///     [column_edges[i], column_edges[i + 1]].
     ///
-    std::optional<std::tuple<double, double>> GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx, size_t interval_idx) const;
+    void GetMinMaxOverDomainColumns(
+        const std::vector<double>& column_edges,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
 
-    std::shared_ptr<std::vector<double>> x_values_;
-    std::shared_ptr<std::vector<std::optional<double>>> y_values_;
+    /// Returns the min and max envelope of the curve in [xmin, xmax] for drawing it `width` pixels wide.
+    ///
+    /// Uses the layer of the tree at which a node spans about a pixel's worth of values, so the running time
+    /// is O(width) regardless of the number of values; the result can be drawn directly as a polyline
+    /// or a filled band (see `GetEnvelope()` in "plot_domain_query.hpp" for details).
+    ///
+    void GetEnvelope(double xmin, double xmax, size_t width, std::vector<EnvelopePoint>& output) const;
 
-    struct Interval
-    {
-        uint32_t lo_idx; ///< Lower bound (inclusive) of the interval; index in `y_values_`.
-        uint32_t hi_idx; ///< Upper bound (inclusive) of the interval; index in `y_values_`.
-        std::optional<std::tuple<double, double>> min_max; ///< Min and max value (from `y_values_`) of the interval.
-    };
+    /// Appends a value to the curve (and to the vectors passed to the constructor).
+    ///
+    /// @param x Must be greater than the last X value.
+    ///
+    /// Runs in amortized O(log n): only the intervals containing the new value are updated,
+    /// and the tree's capacity is doubled when exceeded.
+    ///
+    void Append(double x, const std::optional<T>& y);
 
-    /// Stores a complete binary tree.
+    /// Appends values to the curve (and to the vectors passed to the constructor).
     ///
-    /// Root element ([0]) encompasses indices (0, N-1), where N is `y_values_.size()`
-    /// rounded to the nearest greater power of 2.
-    /// Root's direct children represent intervals (0, N/2-1), (N/2, N-1), and their children
-    /// similarly divide each interval in two.
-    /// Element [i] has children at [2*i+1], [2*i+2].
+    /// @param x_values Must be strictly increasing and greater than the last X value.
+    /// @param y_values Y values corresponding to `x_values`.
     ///
-    std::unique_ptr<Interval[]> intervals_;
+    /// Runs in amortized O(k + log n), where k is the number of appended values.
+    ///
+    void AppendBatch(const std::vector<double>& x_values, const std::vector<std::optional<T>>& y_values);
+
+    /// Replaces the Y value at `idx` (in the vector passed to the constructor); runs in O(log n).
+    void SetValue(size_t idx, const std::optional<T>& y) { y_values_.SetValue(idx, y); }
+
+    /// Replaces the Y values starting at `first_idx` (in the vector passed to the constructor) with `y_values`.
+    ///
+    /// Runs in O(k + log n), where k is the number of values; the ancestors shared by the changed leaves
+    /// are updated once.
+    ///
+    void SetRange(size_t first_idx, const std::vector<std::optional<T>>& y_values) { y_values_.SetRange(first_idx, y_values); }
+
+    /// Replaces all values of the curve and rebuilds the tree in O(n).
+    ///
+    /// @param x_values X values; must be strictly increasing.
+    /// @param y_values Y values corresponding to `x_values`.
+    ///
+    /// The tree's storage is reused if it has enough capacity (e.g. when the curve is refilled with
+    /// a similar number of values), so rebuilding does not allocate.
+    ///
+    void Rebuild(std::shared_ptr<std::vector<double>> x_values, std::shared_ptr<std::vector<std::optional<T>>> y_values);
+
+    /// Validates the X values and builds the tree (and the X index, if requested) if they were deferred
+    /// with `BuildOptions::lazy`; otherwise does nothing.
+    ///
+    /// Called by every query, so calling it explicitly is needed only for pre-warming, e.g. from a background
+    /// thread; it may run concurrently with queries (which wait for it to finish).
+    ///
+    void EnsureBuilt() const;
+
+    const std::vector<double>& GetXValues() const { return *x_values_; }
+    const std::vector<std::optional<T>>& GetYValues() const { return y_values_.GetValues(); }
+
+    /// Returns the tree of min and max values of consecutive blocks of `GetLeafSize()` Y values.
+    const BasicMinMaxTree<T>& GetTree() const { return y_values_.GetTree(); }
+
+    size_t GetLeafSize() const { return y_values_.GetLeafSize(); }
+
+    /// Returns a number which changes whenever the curve is modified (see `ColumnCache`).
+    size_t GetVersion() const { return y_values_.GetVersion(); }
+
+    /// Returns a number identifying the curve; see `BasicValueTree::GetId()`.
+    size_t GetId() const { return y_values_.GetId(); }
+
+private:
+    friend class BasicExplicitCurveBuilder<T>;
+
+    /// Provides the curve's values to the domain queries (see "plot_domain_query.hpp").
+    struct ValueAccess;
+
+    /// See the public constructor; if `are_x_values_validated`, `x_values` are known to be strictly increasing
+    /// (e.g. produced by `BasicExplicitCurveBuilder::Build()`) and are not checked again.
+    BasicExplicitSingleValueCurve2D(
+        std::shared_ptr<std::vector<double>> x_values,
+        std::shared_ptr<std::vector<std::optional<T>>> y_values,
+        const BuildOptions& options,
+        bool are_x_values_validated
+    );
+
+    /// Validates `x_values_` (unless `are_x_values_validated_`) and builds `x_index_` (if requested).
+    void InitializeXValues() const;
+
+    std::shared_ptr<std::vector<double>> x_values_;
+
+    /// True if `x_values_` need not be validated by `InitializeXValues()`.
+    bool are_x_values_validated_;
+
+    /// Built if requested in `BuildOptions`; X values appended later are searched by galloping from its last sample.
+    /// Built on first use if lazy (hence `mutable`).
+    ///
+    mutable XIndex x_index_;
+
+    /// Guards the deferred `InitializeXValues()`; null if performed by the constructor.
+    std::unique_ptr<std::once_flag> x_values_once_;
+
+    BasicValueTree<T> y_values_;
 };
 
+using ExplicitSingleValueCurve2D = BasicExplicitSingleValueCurve2D<double>;
+
 } // namespace plot
 
 #endif // PLOT_H
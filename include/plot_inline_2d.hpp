@@ -0,0 +1,252 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_INLINE_2D_H
+#define PLOT_INLINE_2D_H
+
+#include "plot_min_max_tree.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Same as `PLOT_ASSERT` (always checked), which is private to the library; undefined at the end of this header.
+#define PLOT_INLINE_ASSERT(condition)                                                                      \
+{                                                                                                          \
+    if (!(condition))                                                                                      \
+    {                                                                                                      \
+        std::fprintf(stderr, "Assertion failed at %s:%d inside %s\nCondition: %s\n",                      \
+                     __FILE__, __LINE__, __FUNCTION__, #condition);                                        \
+        std::abort();                                                                                      \
+    }                                                                                                      \
+}
+
+namespace plot {
+
+/// Header-only explicit single-value 2D curve: y = f(x), with the tree's parameters fixed at compile time.
+///
+/// Returns the same results as `BasicExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval()`, but the whole query
+/// is defined in this header, with comparators passed as types (`MinOf`, `MaxOf`); it can thus be inlined into
+/// the caller's loop and optimized with it (the library is not needed). The curve cannot be modified.
+///
+/// The tree is a `BasicMinMaxTree` layout (fanout 2) stored by the curve itself.
+///
+/// @tparam T Type of the stored Y values (an arithmetic type).
+/// @tparam LEAF_SIZE Number of values per leaf of the tree; a power of 2. Being a constant, divisions by it
+///     compile to shifts, and the scans of partially covered leaves have a fixed trip count.
+/// @tparam MAX_LEAVES If not 0, the number of leaves (a power of 2): the tree is then stored in fixed-size arrays
+///     inside the curve (no allocation) and has a fixed depth, for curves of up to `MAX_LEAVES * LEAF_SIZE` values.
+///
+template<typename T, size_t LEAF_SIZE = 8, size_t MAX_LEAVES = 0>
+class InlineExplicitCurve2D
+{
+    static_assert(LEAF_SIZE > 0 && (LEAF_SIZE & (LEAF_SIZE - 1)) == 0, "LEAF_SIZE must be a power of 2");
+    static_assert((MAX_LEAVES & (MAX_LEAVES - 1)) == 0, "MAX_LEAVES must be 0 or a power of 2");
+
+public:
+    using MinMax = BasicMinMax<T>;
+
+    /// Max. number of values; 0 if unlimited.
+    static constexpr size_t MAX_VALUES = MAX_LEAVES * LEAF_SIZE;
+
+    /// Constructor.
+    ///
+    /// @param x_values X values; must be strictly increasing.
+    /// @param y_values Y values corresponding to `x_values`. With `MAX_LEAVES`, there may be at most `MAX_VALUES`.
+    ///
+    InlineExplicitCurve2D(std::shared_ptr<std::vector<double>> x_values, std::shared_ptr<std::vector<std::optional<T>>> y_values)
+    : x_values_(x_values), y_values_(y_values)
+    {
+        const std::vector<double>& x = *x_values_;
+        PLOT_INLINE_ASSERT(x.size() == y_values_->size());
+        for (size_t i = 1; i < x.size(); ++i)
+        {
+            PLOT_INLINE_ASSERT(x[i] > x[i-1]);
+        }
+
+        if constexpr (MAX_LEAVES > 0)
+        {
+            PLOT_INLINE_ASSERT(x.size() <= MAX_VALUES);
+        }
+        else
+        {
+            num_leaves_ = 1;
+            while (num_leaves_ * LEAF_SIZE < x.size()) { num_leaves_ *= 2; }
+            min_.resize(2 * num_leaves_ - 1);
+            max_.resize(2 * num_leaves_ - 1);
+        }
+
+        const size_t num_leaves = GetNumLeaves();
+        for (size_t leaf = 0; leaf < num_leaves; ++leaf)
+        {
+            const size_t begin_idx = std::min(leaf * LEAF_SIZE, x.size());
+            const MinMax min_max = Scan(begin_idx, std::min(begin_idx + LEAF_SIZE, x.size()));
+            min_[num_leaves - 1 + leaf] = min_max.min;
+            max_[num_leaves - 1 + leaf] = min_max.max;
+        }
+        for (size_t node = num_leaves - 1; node-- > 0;)
+        {
+            min_[node] = MinOf{}(min_[2 * node + 1], min_[2 * node + 2]);
+            max_[node] = MaxOf{}(max_[2 * node + 1], max_[2 * node + 2]);
+        }
+    }
+
+    size_t GetNumValues() const { return x_values_->size(); }
+
+    size_t GetNumLeaves() const
+    {
+        if constexpr (MAX_LEAVES > 0) { return MAX_LEAVES; } else { return num_leaves_; }
+    }
+
+    /// Returns the min and max Y value in the interval [xmin, xmax]; or `std::nullopt` if the interval contains no values.
+    ///
+    /// See `BasicExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval()`.
+    ///
+    std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(double xmin, double xmax) const
+    {
+        const std::vector<double>& x = *x_values_;
+
+        const size_t lo_idx = std::lower_bound(x.begin(), x.end(), xmin) - x.begin();
+        const size_t hi_lower_bound = std::lower_bound(x.begin(), x.end(), xmax) - x.begin();
+        const size_t hi_bound = (hi_lower_bound < x.size() && x[hi_lower_bound] == xmax) ? hi_lower_bound + 1 : hi_lower_bound;
+
+        if (lo_idx == x.size() || hi_bound == 0) { return std::nullopt; }
+
+        // the interpolated values count only if there are none inside the interval, or together with them
+        BasicMinMax<double> result = BasicMinMax<double>::Empty();
+        if (hi_bound > lo_idx)
+        {
+            const MinMax inside = GetMinMaxOverIndexInterval(lo_idx, hi_bound - 1);
+            if (!inside.IsEmpty()) { result = ToMinMax(inside); }
+        }
+        Add(result, Interpolate(xmin, lo_idx));
+        Add(result, Interpolate(xmax, hi_lower_bound));
+
+        if (result.IsEmpty()) { return std::nullopt; }
+
+        return std::make_tuple(result.min, result.max);
+    }
+
+    /// Returns the min and max of the non-empty Y values [lo_idx, hi_idx].
+    MinMax GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx) const
+    {
+        size_t first_leaf = lo_idx / LEAF_SIZE;
+        size_t end_leaf = hi_idx / LEAF_SIZE + 1;
+
+        if (first_leaf + 1 == end_leaf && (lo_idx % LEAF_SIZE != 0 || (hi_idx + 1) % LEAF_SIZE != 0))
+        {
+            return Scan(lo_idx, hi_idx + 1);
+        }
+
+        MinMax result = MinMax::Empty();
+        if (lo_idx % LEAF_SIZE != 0)
+        {
+            Add(result, Scan(lo_idx, (first_leaf + 1) * LEAF_SIZE));
+            ++first_leaf;
+        }
+        if ((hi_idx + 1) % LEAF_SIZE != 0)
+        {
+            --end_leaf;
+            Add(result, Scan(end_leaf * LEAF_SIZE, hi_idx + 1));
+        }
+
+        // walks up the tree from both ends of the leaf interval (see `BasicMinMaxTreeView::GetMinMaxOverLeafInterval()`)
+        size_t lo = GetNumLeaves() + first_leaf;
+        size_t hi = GetNumLeaves() + end_leaf;
+        while (lo < hi)
+        {
+            if (lo & 1)
+            {
+                Add(result, MinMax{min_[lo - 1], max_[lo - 1]});
+                ++lo;
+            }
+            if (hi & 1)
+            {
+                --hi;
+                Add(result, MinMax{min_[hi - 1], max_[hi - 1]});
+            }
+            lo >>= 1;
+            hi >>= 1;
+        }
+
+        return result;
+    }
+
+    const std::vector<double>& GetXValues() const { return *x_values_; }
+    const std::vector<std::optional<T>>& GetYValues() const { return *y_values_; }
+
+private:
+    using Storage = std::conditional_t<MAX_LEAVES == 0, std::vector<T>, std::array<T, (MAX_LEAVES > 0 ? 2 * MAX_LEAVES - 1 : 1)>>;
+
+    template<typename V>
+    static void Add(BasicMinMax<V>& result, const BasicMinMax<V>& other)
+    {
+        result.min = MinOf{}(result.min, other.min);
+        result.max = MaxOf{}(result.max, other.max);
+    }
+
+    static void Add(BasicMinMax<double>& result, const std::optional<double>& value)
+    {
+        if (value.has_value()) { Add(result, BasicMinMax<double>{*value, *value}); }
+    }
+
+    /// Returns the min and max of the non-empty Y values in [begin_idx, end_idx).
+    MinMax Scan(size_t begin_idx, size_t end_idx) const
+    {
+        const std::vector<std::optional<T>>& y = *y_values_;
+
+        MinMax result = MinMax::Empty();
+        for (size_t i = begin_idx; i < end_idx; ++i)
+        {
+            if (y[i].has_value()) { Add(result, MinMax{*y[i], *y[i]}); }
+        }
+
+        return result;
+    }
+
+    /// See `GetInterpolatedValue()` in "plot_domain_query.hpp".
+    std::optional<double> Interpolate(double x, size_t lo_idx) const
+    {
+        const std::vector<double>& x_values = *x_values_;
+        const std::vector<std::optional<T>>& y = *y_values_;
+
+        if (lo_idx == 0 || lo_idx >= x_values.size() || !(x_values[lo_idx] > x)) { return std::nullopt; }
+        if (!y[lo_idx - 1].has_value() || !y[lo_idx].has_value()) { return std::nullopt; }
+
+        const double x_lo = x_values[lo_idx - 1];
+        const double x_hi = x_values[lo_idx];
+        const double y_lo = static_cast<double>(*y[lo_idx - 1]);
+        const double y_hi = static_cast<double>(*y[lo_idx]);
+
+        return y_lo + (x - x_lo) / (x_hi - x_lo) * (y_hi - y_lo);
+    }
+
+    std::shared_ptr<std::vector<double>> x_values_;
+    std::shared_ptr<std::vector<std::optional<T>>> y_values_;
+
+    /// Used if `MAX_LEAVES` is 0.
+    size_t num_leaves_{0};
+
+    Storage min_{};
+    Storage max_{};
+};
+
+} // namespace plot
+
+#undef PLOT_INLINE_ASSERT
+
+#endif // PLOT_INLINE_2D_H
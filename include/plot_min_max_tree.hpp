@@ -0,0 +1,434 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_MIN_MAX_TREE_H
+#define PLOT_MIN_MAX_TREE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <type_traits>
+
+namespace plot {
+
+/// Min and max of a set of values. An empty set is represented by `min` > `max`.
+///
+/// @tparam T Value type: `double`, `float`, `int32_t` or `int16_t`.
+///
+template<typename T>
+struct BasicMinMax
+{
+    T min;
+    T max;
+
+    /// Returns the empty set: infinities for floating-point types, the extreme values for integers
+    /// (a non-empty set of integers has min <= max even if it contains the extreme values).
+    static BasicMinMax Empty()
+    {
+        if constexpr (std::numeric_limits<T>::has_infinity)
+        {
+            return {std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity()};
+        }
+        else
+        {
+            return {std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest()};
+        }
+    }
+
+    bool IsEmpty() const { return min > max; }
+
+    void Add(T value)
+    {
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    void Add(const BasicMinMax& other)
+    {
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+};
+
+using MinMax = BasicMinMax<double>;
+
+/// Comparator policy returning the lesser of two values (see `MaxOf`).
+///
+/// Passed as a type rather than a function pointer, so that calls through it can be inlined.
+///
+struct MinOf
+{
+    template<typename V>
+    V operator()(V a, V b) const { return std::min(a, b); }
+};
+
+/// Comparator policy returning the greater of two values (see `MinOf`).
+struct MaxOf
+{
+    template<typename V>
+    V operator()(V a, V b) const { return std::max(a, b); }
+};
+
+/// Converts to `MinMax`; an empty set remains empty.
+template<typename T>
+MinMax ToMinMax(const BasicMinMax<T>& min_max)
+{
+    return {static_cast<double>(min_max.min), static_cast<double>(min_max.max)};
+}
+
+// Aggregation policies of `BasicMinMaxTree`: what each node stores besides the min and max.
+// Each provides:
+//
+//   struct Extra;                           // trivially copyable; stored in an array of its own
+//   static constexpr bool HAS_EXTRA;        // if false, `Extra` is not stored at all
+//   static Extra EmptyExtra();              // extra values of no values
+//   static Extra CombineExtra(const Extra& a, const Extra& b);
+//                                           // extra values of the interval of `a` followed by that of `b`
+//   template<typename T>
+//   static Extra ScanExtra(const std::optional<T>* values, size_t count);
+//                                           // extra values of `values[0]`...`values[count-1]`
+
+/// Only min and max; the nodes are `BasicMinMax`.
+struct MinMaxAggregation
+{
+    struct Extra {};
+
+    static constexpr bool HAS_EXTRA = false;
+
+    static Extra EmptyExtra() { return {}; }
+
+    static Extra CombineExtra(const Extra&, const Extra&) { return {}; }
+
+    template<typename T>
+    static Extra ScanExtra(const std::optional<T>*, size_t) { return {}; }
+};
+
+/// Also the sum, count, first and last of the non-empty values (e.g. for OHLC candles, or for connecting
+/// the envelopes of adjacent columns).
+struct FullAggregation
+{
+    struct Extra
+    {
+        double sum;
+        size_t count; ///< Number of non-empty values.
+        double first; ///< First non-empty value; unspecified if `count` is 0.
+        double last;  ///< Last non-empty value; unspecified if `count` is 0.
+    };
+
+    static constexpr bool HAS_EXTRA = true;
+
+    static Extra EmptyExtra()
+    {
+        constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+        return {0.0, 0, NaN, NaN};
+    }
+
+    static Extra CombineExtra(const Extra& a, const Extra& b)
+    {
+        if (a.count == 0) { return b; }
+        if (b.count == 0) { return a; }
+
+        return {a.sum + b.sum, a.count + b.count, a.first, b.last};
+    }
+
+    template<typename T>
+    static Extra ScanExtra(const std::optional<T>* values, size_t count)
+    {
+        Extra result = EmptyExtra();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!values[i].has_value()) { continue; }
+
+            const double value = static_cast<double>(*values[i]);
+            if (result.count == 0) { result.first = value; }
+            result.sum += value;
+            result.last = value;
+            ++result.count;
+        }
+
+        return result;
+    }
+};
+
+/// Min and max of a set of values, and the extra values of `Aggregation`.
+template<typename T, typename Aggregation>
+struct BasicAggregateNode: BasicMinMax<T>
+{
+    typename Aggregation::Extra extra;
+
+    static BasicAggregateNode Empty() { return {BasicMinMax<T>::Empty(), Aggregation::EmptyExtra()}; }
+
+    /// Adds the values of `following`, which come after those of this node.
+    void Add(const BasicAggregateNode& following)
+    {
+        BasicMinMax<T>::Add(following);
+        extra = Aggregation::CombineExtra(extra, following.extra);
+    }
+};
+
+/// Node of a `BasicMinMaxTree`: just `BasicMinMax` if `Aggregation` has no extra values.
+template<typename T, typename Aggregation>
+using TreeNode = std::conditional_t<Aggregation::HAS_EXTRA, BasicAggregateNode<T, Aggregation>, BasicMinMax<T>>;
+
+/// Read-only view of the nodes of a `BasicMinMaxTree`, which may be stored elsewhere (e.g. in a memory-mapped file).
+///
+/// See `BasicMinMaxTree` for the layout.
+///
+template<typename T, typename Aggregation = MinMaxAggregation>
+class BasicMinMaxTreeView
+{
+public:
+    using MinMax = BasicMinMax<T>;
+    using Extra = typename Aggregation::Extra;
+    using Node = TreeNode<T, Aggregation>;
+
+    BasicMinMaxTreeView() = default;
+
+    /// @param num_leaves Must be a power of 2.
+    /// @param min_values Min value of each of the (2 * `num_leaves` - 1) nodes.
+    /// @param max_values Max value of each of the (2 * `num_leaves` - 1) nodes.
+    /// @param extra_values Extra values of each node; only used if `Aggregation::HAS_EXTRA`.
+    ///
+    BasicMinMaxTreeView(size_t num_leaves, const T* min_values, const T* max_values, const Extra* extra_values = nullptr)
+    : num_leaves_(num_leaves), min_(min_values), max_(max_values), extra_(extra_values)
+    {}
+
+    size_t GetNumLeaves() const { return num_leaves_; }
+
+    size_t GetNumNodes() const { return num_leaves_ > 0 ? 2 * num_leaves_ - 1 : 0; }
+
+    Node GetNode(size_t node_idx) const
+    {
+        if constexpr (Aggregation::HAS_EXTRA)
+        {
+            return {{min_[node_idx], max_[node_idx]}, extra_[node_idx]};
+        }
+        else
+        {
+            return {min_[node_idx], max_[node_idx]};
+        }
+    }
+
+    /// Returns the node spanning leaves [block_idx * block_size, (block_idx + 1) * block_size).
+    ///
+    /// @param block_size Number of leaves; must be a power of 2 not greater than `GetNumLeaves()`.
+    ///
+    /// Each layer of the tree is the min and max envelope of the leaves decimated by a power of 2,
+    /// so reading one block takes O(1).
+    ///
+    Node GetBlock(size_t block_idx, size_t block_size) const { return GetNode(num_leaves_ / block_size - 1 + block_idx); }
+
+    const T* GetMinValues() const { return min_; }
+
+    const T* GetMaxValues() const { return max_; }
+
+    const Extra* GetExtraValues() const { return extra_; }
+
+    /// Returns the min and max value (and the extra values) of leaves [first_leaf, last_leaf].
+    ///
+    /// Walks up the tree from both ends of the interval at once; there is no recursion.
+    /// Nodes are combined in sequence order, so order-dependent extra values (e.g. first, last) are correct.
+    ///
+    Node GetMinMaxOverLeafInterval(size_t first_leaf, size_t last_leaf) const;
+
+    /// Returns the same result as `GetMinMaxOverLeafInterval()` by descending recursively from the root.
+    ///
+    /// Slower; kept as a reference implementation for testing and benchmarking.
+    ///
+    Node GetMinMaxOverLeafIntervalRecursive(size_t first_leaf, size_t last_leaf) const;
+
+private:
+    /// Returns the min and max value of leaves [first_leaf, last_leaf] contained in node `node_idx`
+    /// which spans leaves [node_first, node_last].
+    Node GetMinMaxOverLeafIntervalRecursive(
+        size_t first_leaf,
+        size_t last_leaf,
+        size_t node_idx,
+        size_t node_first,
+        size_t node_last
+    ) const;
+
+    size_t num_leaves_{0};
+    const T* min_{nullptr};
+    const T* max_{nullptr};
+    const Extra* extra_{nullptr};
+};
+
+using MinMaxTreeView = BasicMinMaxTreeView<double>;
+
+/// Complete binary tree storing the min and max value of consecutive intervals ("leaves") of a sequence.
+///
+/// Consider 8 leaves (L = 8). The tree's nodes are stored as follows:
+///
+/// layer 0, index 0:       (0,7),
+/// layer 1, indices 1-2:   (0,3), (4,7),
+/// layer 2, indices 3-6:   (0,1), (2,3), (4,5), (6,7),
+/// layer 3, indices 7-14:  (0), (1), (2), (3), (4), (5), (6), (7)
+///
+/// Node at index `i` has children at 2*i+1, 2*i+2. The leaves start at index L-1.
+///
+/// All index arithmetic uses `size_t`, so on 64-bit platforms the number of leaves is limited only by memory.
+///
+/// Nodes do not store their bounds; these follow from a node's position and are derived during descent.
+/// Min and max values are stored in separate contiguous arrays of `T` (see `BasicMinMax`);
+/// empty nodes have min > max. Narrow value types make the tree proportionally smaller.
+///
+/// @tparam Aggregation `MinMaxAggregation` (the default) or `FullAggregation`; the latter's extra values
+///     (see `BasicAggregateNode`) are stored in a third array, after the min and max arrays.
+///
+/// All arrays are a single allocation from a `std::pmr::memory_resource`, which is kept when the number
+/// of leaves is reduced (see `ResizeUninitialized()`), so that rebuilding a tree does not need to allocate.
+///
+template<typename T, typename Aggregation = MinMaxAggregation>
+class BasicMinMaxTree
+{
+public:
+    using MinMax = BasicMinMax<T>;
+    using Extra = typename Aggregation::Extra;
+    using Node = TreeNode<T, Aggregation>;
+    using View = BasicMinMaxTreeView<T, Aggregation>;
+
+    static_assert(std::is_trivially_copyable_v<Extra>);
+
+    /// Number of bytes of storage per node.
+    static constexpr size_t NODE_SIZE = 2 * sizeof(T) + (Aggregation::HAS_EXTRA ? sizeof(Extra) : 0);
+
+    BasicMinMaxTree() = default;
+
+    /// Creates a tree with all leaves empty.
+    ///
+    /// @param num_leaves Must be a power of 2 (or 0 for a tree to be resized with `ResizeUninitialized()`).
+    /// @param resource Allocates the nodes; must outlive the tree.
+    ///
+    explicit BasicMinMaxTree(size_t num_leaves, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    ~BasicMinMaxTree();
+
+    BasicMinMaxTree(const BasicMinMaxTree&) = delete;
+    BasicMinMaxTree& operator=(const BasicMinMaxTree&) = delete;
+
+    BasicMinMaxTree(BasicMinMaxTree&& other);
+    BasicMinMaxTree& operator=(BasicMinMaxTree&& other);
+
+    /// Returns the number of leaves (at least 1) needed to store `num_values` with `leaf_size` values per leaf.
+    ///
+    /// @param leaf_size Must be a power of 2.
+    ///
+    static size_t GetNumLeavesFor(size_t num_values, size_t leaf_size);
+
+    size_t GetNumLeaves() const { return num_leaves_; }
+
+    size_t GetNumNodes() const { return num_leaves_ > 0 ? 2 * num_leaves_ - 1 : 0; }
+
+    /// Returns the max. number of leaves which fit in the allocated storage.
+    size_t GetCapacity() const { return capacity_; }
+
+    std::pmr::memory_resource* GetMemoryResource() const { return resource_; }
+
+    /// Changes the number of leaves to `num_leaves` (a power of 2); the storage is reallocated only if
+    /// `num_leaves` exceeds `GetCapacity()`.
+    ///
+    /// The nodes' values are left unspecified (and are not initialized, to avoid touching memory twice);
+    /// all leaves have to be set afterwards with `SetLeaf()`, followed by `FillInternalNodes()`.
+    ///
+    void ResizeUninitialized(size_t num_leaves);
+
+    Node GetNode(size_t node_idx) const { return GetView().GetNode(node_idx); }
+
+    View GetView() const { return View(num_leaves_, min_, max_, extra_); }
+
+    /// See `BasicMinMaxTreeView::GetBlock()`.
+    Node GetBlock(size_t block_idx, size_t block_size) const { return GetView().GetBlock(block_idx, block_size); }
+
+    /// Sets a leaf's value; its ancestors have to be updated afterwards with `FillInternalNodes()` or `UpdateAncestors()`.
+    void SetLeaf(size_t leaf_idx, const Node& value)
+    {
+        min_[num_leaves_ - 1 + leaf_idx] = value.min;
+        max_[num_leaves_ - 1 + leaf_idx] = value.max;
+        if constexpr (Aggregation::HAS_EXTRA) { extra_[num_leaves_ - 1 + leaf_idx] = value.extra; }
+    }
+
+    /// Recalculates all non-leaf nodes.
+    ///
+    /// @param num_threads Number of threads to use; 0 means all hardware threads. The subtrees below
+    ///     the top layers are filled in parallel, then the top layers serially; the result does not depend
+    ///     on the number of threads.
+    /// @param cancel If not null, checked before each layer; once it is true, filling stops.
+    /// @return False if cancelled (leaving the nodes partially filled).
+    ///
+    bool FillInternalNodes(unsigned num_threads = 1, const std::atomic<bool>* cancel = nullptr);
+
+    /// Recalculates the ancestors of leaves [first_leaf, last_leaf]; each ancestor is recalculated once.
+    void UpdateAncestors(size_t first_leaf, size_t last_leaf);
+
+    /// See `BasicMinMaxTreeView::GetMinMaxOverLeafInterval()`.
+    Node GetMinMaxOverLeafInterval(size_t first_leaf, size_t last_leaf) const
+    {
+        return GetView().GetMinMaxOverLeafInterval(first_leaf, last_leaf);
+    }
+
+    /// See `BasicMinMaxTreeView::GetMinMaxOverLeafIntervalRecursive()`.
+    Node GetMinMaxOverLeafIntervalRecursive(size_t first_leaf, size_t last_leaf) const
+    {
+        return GetView().GetMinMaxOverLeafIntervalRecursive(first_leaf, last_leaf);
+    }
+
+private:
+    /// Alignment of `storage_`.
+    static constexpr size_t STORAGE_ALIGNMENT = std::max(alignof(T), alignof(Extra));
+
+    /// Returns the offset in bytes of the extra values in the storage for `num_nodes`.
+    static size_t GetExtraOffset(size_t num_nodes)
+    {
+        return (2 * num_nodes * sizeof(T) + alignof(Extra) - 1) / alignof(Extra) * alignof(Extra);
+    }
+
+    /// Returns the size in bytes of the storage for `num_nodes`.
+    static size_t GetStorageSize(size_t num_nodes)
+    {
+        return Aggregation::HAS_EXTRA ? GetExtraOffset(num_nodes) + num_nodes * sizeof(Extra) : 2 * num_nodes * sizeof(T);
+    }
+
+    /// Updates the value of a non-leaf node from its children.
+    void UpdateNode(size_t node_idx)
+    {
+        min_[node_idx] = std::min(min_[2 * node_idx + 1], min_[2 * node_idx + 2]);
+        max_[node_idx] = std::max(max_[2 * node_idx + 1], max_[2 * node_idx + 2]);
+        if constexpr (Aggregation::HAS_EXTRA)
+        {
+            extra_[node_idx] = Aggregation::CombineExtra(extra_[2 * node_idx + 1], extra_[2 * node_idx + 2]);
+        }
+    }
+
+    void Deallocate();
+
+    size_t num_leaves_{0};
+
+    size_t capacity_{0}; ///< Number of leaves for which `storage_` is allocated.
+
+    std::pmr::memory_resource* resource_{std::pmr::get_default_resource()};
+
+    /// Holds `max_` after `min_` (then `extra_`, if used), each for (2 * `capacity_` - 1) nodes.
+    void* storage_{nullptr};
+
+    T* min_{nullptr}; ///< Min value of each node.
+    T* max_{nullptr}; ///< Max value of each node.
+    Extra* extra_{nullptr}; ///< Extra values of each node; null if `Aggregation` has none.
+};
+
+using MinMaxTree = BasicMinMaxTree<double>;
+
+} // namespace plot
+
+#endif // PLOT_MIN_MAX_TREE_H
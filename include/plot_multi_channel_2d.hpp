@@ -0,0 +1,135 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_MULTI_CHANNEL_2D_H
+#define PLOT_MULTI_CHANNEL_2D_H
+
+#include "plot_value_tree.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace plot {
+
+/// Min and max values of several channels over one or more columns, as a structure of arrays.
+///
+/// The values of the r-th queried channel in column `i` are at index `r * num_columns + i`.
+/// If there are no values, min > max (as in `MinMax`).
+///
+struct MultiChannelMinMax
+{
+    size_t num_columns{0};
+    std::vector<double> min;
+    std::vector<double> max;
+
+    bool IsEmpty(size_t idx) const { return min[idx] > max[idx]; }
+};
+
+/// Working buffers of `BasicMultiChannelCurve2D::GetMinMaxOverDomainColumns()`; passing the same one to repeated
+/// queries (e.g. once per frame) avoids allocating them each time. Its contents are unspecified between queries.
+class MultiChannelScratch
+{
+private:
+    template<typename T>
+    friend class BasicMultiChannelCurve2D;
+
+    std::vector<size_t> edge_lo_idx_;
+    std::vector<size_t> edge_hi_bound_;
+    std::vector<std::optional<double>> edge_interp_;
+};
+
+/// Set of explicit single-value 2D curves ("channels") sharing X values: y_c = f_c(x).
+///
+/// Each query searches the X values once and then reads the min and max of every requested channel
+/// from its tree, instead of repeating the search for each channel.
+///
+/// @tparam T See `BasicExplicitSingleValueCurve2D`.
+///
+template<typename T>
+class BasicMultiChannelCurve2D
+{
+public:
+    /// Constructor.
+    ///
+    /// @param x_values X values; must be strictly increasing. May be empty.
+    /// @param channels Y values of each channel; each has the same size as `x_values`.
+    /// @param options Build options (used for every channel); also used when the trees are rebuilt after appending values.
+    ///
+    BasicMultiChannelCurve2D(
+        std::shared_ptr<std::vector<double>> x_values,
+        const std::vector<std::shared_ptr<std::vector<std::optional<T>>>>& channels,
+        const BuildOptions& options = {}
+    );
+
+    size_t GetNumChannels() const { return channels_.size(); }
+
+    /// Returns the min and max Y value of each channel in the interval [xmin, xmax] (`output.num_columns` is 1).
+    ///
+    /// The result for each channel is the same as `ExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval()`.
+    ///
+    void GetMinMaxOverDomainInterval(double xmin, double xmax, MultiChannelMinMax& output) const;
+
+    /// Returns the min and max Y value of each of `channels` (indices) in the interval [xmin, xmax].
+    void GetMinMaxOverDomainInterval(double xmin, double xmax, const std::vector<size_t>& channels, MultiChannelMinMax& output) const;
+
+    /// Returns the min and max Y value of each channel for each of `num_columns` equal-width columns spanning [xmin, xmax].
+    ///
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`.
+    ///
+    /// @param scratch If not null, provides the working buffers (otherwise they are allocated for the call).
+    ///
+    void GetMinMaxOverDomainColumns(
+        double xmin,
+        double xmax,
+        size_t num_columns,
+        MultiChannelMinMax& output,
+        MultiChannelScratch* scratch = nullptr
+    ) const;
+
+    /// Returns the min and max Y value of each of `channels` (indices) for each of `num_columns` columns.
+    void GetMinMaxOverDomainColumns(
+        double xmin,
+        double xmax,
+        size_t num_columns,
+        const std::vector<size_t>& channels,
+        MultiChannelMinMax& output,
+        MultiChannelScratch* scratch = nullptr
+    ) const;
+
+    /// Appends a value to each channel (and to the vectors passed to the constructor).
+    ///
+    /// @param x Must be greater than the last X value.
+    /// @param y_values Y value of each channel.
+    ///
+    void Append(double x, const std::vector<std::optional<T>>& y_values);
+
+    const std::vector<double>& GetXValues() const { return *x_values_; }
+
+    const std::vector<std::optional<T>>& GetYValues(size_t channel) const { return channels_[channel].GetValues(); }
+
+private:
+    /// Provides the values of one channel to the domain queries (see "plot_domain_query.hpp").
+    struct ValueAccess;
+
+    std::shared_ptr<std::vector<double>> x_values_;
+
+    std::vector<BasicValueTree<T>> channels_;
+
+    /// Indices of all channels (for the queries of all channels).
+    std::vector<size_t> all_channels_;
+};
+
+using MultiChannelCurve2D = BasicMultiChannelCurve2D<double>;
+
+} // namespace plot
+
+#endif // PLOT_MULTI_CHANNEL_2D_H
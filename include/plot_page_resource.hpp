@@ -0,0 +1,159 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_PAGE_RESOURCE_H
+#define PLOT_PAGE_RESOURCE_H
+
+#include "plot_value_tree.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace plot {
+
+enum class HugePages
+{
+    None,
+    /// Regions aligned to `HUGE_PAGE_SIZE` are marked for transparent huge pages (`madvise(MADV_HUGEPAGE)`);
+    /// effective if THP is enabled as "always" or "madvise".
+    Transparent,
+    /// Regions are mapped from the reserved huge page pool (`MAP_HUGETLB`); falls back to `Transparent`
+    /// if the pool is exhausted or not configured.
+    Explicit
+};
+
+enum class NumaPolicy
+{
+    /// The kernel's default: pages are placed on the node of the thread first touching them.
+    Default,
+    /// Pages are spread round-robin over the nodes, so that threads on all nodes see the same average latency.
+    Interleave,
+    /// Pages are placed on the given nodes only (see `NumaReplicated`).
+    Bind
+};
+
+/// Size and alignment of the regions allocated with huge pages.
+constexpr size_t HUGE_PAGE_SIZE = size_t{1} << 21;
+
+/// Options of a `PageResource`.
+struct PageResourceOptions
+{
+    HugePages huge_pages{HugePages::None};
+
+    NumaPolicy numa_policy{NumaPolicy::Default};
+
+    /// Nodes used by `NumaPolicy::Interleave` and `NumaPolicy::Bind`; empty means all nodes.
+    std::vector<unsigned> numa_nodes;
+};
+
+/// Memory resource mapping each allocation directly from the OS, optionally with huge pages and a NUMA policy.
+///
+/// Meant for the trees of large curves (see `BuildOptions::memory_resource`), where huge pages reduce TLB misses
+/// during the descent of a query, and NUMA placement avoids all query threads of one socket paying for remote
+/// memory. Each allocation is rounded up to whole pages (or to `HUGE_PAGE_SIZE`), so this is wasteful for small ones.
+///
+/// Huge pages and NUMA policies are best effort: if the system does not support them, the memory is allocated
+/// without them. Thread-safe.
+///
+class PageResource: public std::pmr::memory_resource
+{
+public:
+    /// Constructor; reads the list of NUMA nodes (see `GetNumaNodes()`) if the policy needs all of them.
+    explicit PageResource(const PageResourceOptions& options = {});
+
+    const PageResourceOptions& GetOptions() const { return options_; }
+
+private:
+    void* do_allocate(size_t num_bytes, size_t alignment) override;
+
+    void do_deallocate(void* ptr, size_t num_bytes, size_t alignment) override;
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    /// Returns the size of the region mapped for an allocation of `num_bytes`.
+    size_t GetMappedSize(size_t num_bytes) const;
+
+    PageResourceOptions options_;
+
+    /// Node mask of `options_.numa_policy` (in the format of `mbind(2)`), resolved by the constructor;
+    /// empty for `NumaPolicy::Default`.
+    std::vector<unsigned long> node_mask_;
+};
+
+/// Returns the NUMA nodes of the system (as listed in /sys/devices/system/node/online), or {0} if not available.
+std::vector<unsigned> GetNumaNodes();
+
+/// Returns the NUMA node of the CPU running the calling thread, or 0 if not available.
+unsigned GetCurrentNumaNode();
+
+/// A read-mostly curve replicated on each NUMA node, so that query threads read their node's local copy of the tree.
+///
+/// @tparam Curve Type of the curve, e.g. `ExplicitSingleValueCurve2D`.
+///
+template<typename Curve>
+class NumaReplicated
+{
+public:
+    /// Constructor.
+    ///
+    /// @param make_curve Called as `make_curve(options)` for each node (with `BuildOptions::memory_resource`
+    ///     allocating on that node) to construct the curve, e.g.
+    ///     `[=](const BuildOptions& o) { return ExplicitSingleValueCurve2D(x, y, o); }`. Values which the curve
+    ///     shares with the caller (such as the vectors of X and Y values) are not replicated.
+    /// @param options Options passed to `make_curve`.
+    /// @param huge_pages Huge pages used by the replicas.
+    /// @param nodes Nodes to replicate the curve on; empty means all nodes.
+    ///
+    template<typename MakeCurve>
+    NumaReplicated(MakeCurve make_curve, const BuildOptions& options = {}, HugePages huge_pages = HugePages::None, std::vector<unsigned> nodes = {})
+    : nodes_(nodes.empty() ? GetNumaNodes() : std::move(nodes))
+    {
+        for (unsigned node: nodes_)
+        {
+            resources_.push_back(std::make_unique<PageResource>(PageResourceOptions{huge_pages, NumaPolicy::Bind, {node}}));
+
+            BuildOptions replica_options = options;
+            replica_options.memory_resource = resources_.back().get();
+            replicas_.push_back(std::make_unique<Curve>(make_curve(replica_options)));
+        }
+    }
+
+    size_t GetNumReplicas() const { return replicas_.size(); }
+
+    /// Returns the replica on the calling thread's node (or the first one, if the node has none).
+    const Curve& Get() const
+    {
+        const unsigned node = GetCurrentNumaNode();
+        for (size_t i = 0; i < nodes_.size(); ++i)
+        {
+            if (nodes_[i] == node) { return *replicas_[i]; }
+        }
+
+        return *replicas_.front();
+    }
+
+    /// Returns the replica on `nodes[idx]`; e.g. for modifying each one the same way.
+    Curve& GetReplica(size_t idx) { return *replicas_[idx]; }
+
+private:
+    std::vector<unsigned> nodes_;
+
+    /// Allocate the replicas' trees; declared before `replicas_` to outlive them.
+    std::vector<std::unique_ptr<PageResource>> resources_;
+
+    std::vector<std::unique_ptr<Curve>> replicas_;
+};
+
+} // namespace plot
+
+#endif // PLOT_PAGE_RESOURCE_H
@@ -0,0 +1,110 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_RING_BUFFER_2D_H
+#define PLOT_RING_BUFFER_2D_H
+
+#include "plot_value_tree.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace plot {
+
+/// Explicit single-value 2D curve of the last `capacity` appended values: y = f(x).
+///
+/// Values are stored in a ring buffer; once it is full, each appended value overwrites the oldest one and
+/// only the tree nodes covering it are updated. Memory is allocated only by the constructor.
+///
+/// Values are addressed by their logical index (0 being the oldest one), which is mapped to a slot
+/// of the buffer; a logical index interval corresponds to at most 2 intervals of slots.
+///
+/// @tparam T See `BasicExplicitSingleValueCurve2D`.
+///
+template<typename T>
+class BasicRingBufferCurve2D
+{
+public:
+    /// Constructor; creates an empty curve.
+    ///
+    /// @param capacity Max. number of values; must be positive.
+    /// @param options Build options.
+    ///
+    explicit BasicRingBufferCurve2D(size_t capacity, const BuildOptions& options = {});
+
+    /// Appends a value, overwriting the oldest one if the curve is full; runs in O(log n).
+    ///
+    /// @param x Must be greater than the last X value.
+    ///
+    void Append(double x, const std::optional<T>& y);
+
+    size_t GetNumValues() const { return num_values_; }
+
+    size_t GetCapacity() const { return x_values_.size(); }
+
+    /// Returns a number which changes whenever the curve is modified (see `ColumnCache`).
+    size_t GetVersion() const { return y_values_.GetVersion(); }
+
+    /// Returns a number identifying the curve; see `BasicValueTree::GetId()`.
+    size_t GetId() const { return y_values_.GetId(); }
+
+    /// Returns the X value with logical index `idx`.
+    double GetX(size_t idx) const { return x_values_[GetSlot(idx)]; }
+
+    /// Returns the Y value with logical index `idx`.
+    const std::optional<T>& GetY(size_t idx) const { return y_values_.GetValues()[GetSlot(idx)]; }
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval()`.
+    std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(double xmin, double xmax) const;
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`.
+    void GetMinMaxOverDomainColumns(
+        double xmin,
+        double xmax,
+        size_t num_columns,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`.
+    void GetMinMaxOverDomainColumns(
+        const std::vector<double>& column_edges,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+private:
+    /// Provides the curve's values to the domain queries (see "plot_domain_query.hpp").
+    struct ValueAccess;
+
+    /// Returns the slot of the value with logical index `idx`.
+    size_t GetSlot(size_t idx) const
+    {
+        const size_t slot = first_slot_ + idx;
+        return slot < x_values_.size() ? slot : slot - x_values_.size();
+    }
+
+    std::vector<double> x_values_;
+
+    /// Y values of all slots; the slots not holding a value are empty.
+    BasicValueTree<T> y_values_;
+
+    /// Slot of the oldest value.
+    size_t first_slot_{0};
+
+    size_t num_values_{0};
+};
+
+using RingBufferCurve2D = BasicRingBufferCurve2D<double>;
+
+} // namespace plot
+
+#endif // PLOT_RING_BUFFER_2D_H
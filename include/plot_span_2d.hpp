@@ -0,0 +1,99 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_SPAN_2D_H
+#define PLOT_SPAN_2D_H
+
+#include "plot_min_max_tree.hpp"
+#include "plot_value_tree.hpp"
+#include "plot_x_index.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace plot {
+
+/// Explicit single-value 2D curve over values owned by the caller: y = f(x).
+///
+/// Only the tree is allocated; X and Y values are read in place (e.g. from a ring buffer, a column
+/// of a columnar table or a memory-mapped file) and must outlive the curve and remain unchanged.
+///
+class SpanExplicitSingleValueCurve2D
+{
+public:
+    /// Constructor.
+    ///
+    /// @param x_values `num_values` X values; must be strictly increasing.
+    /// @param y_values `num_values` Y values corresponding to `x_values`.
+    /// @param validity If not null, bit `i % 8` of byte `i / 8` is set if `y_values[i]` is valid
+    ///     (the layout used by Arrow and by curve files). If null, NaN Y values are treated as missing.
+    /// @param options Build options.
+    ///
+    SpanExplicitSingleValueCurve2D(
+        const double* x_values,
+        const double* y_values,
+        size_t num_values,
+        const uint8_t* validity = nullptr,
+        const BuildOptions& options = {}
+    );
+
+    size_t GetNumValues() const { return num_values_; }
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval()`.
+    std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(double xmin, double xmax) const;
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval()`.
+    std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(double xmin, double xmax, SearchHint& hint) const;
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`.
+    void GetMinMaxOverDomainColumns(
+        double xmin,
+        double xmax,
+        size_t num_columns,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`.
+    void GetMinMaxOverDomainColumns(
+        const std::vector<double>& column_edges,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+    /// Returns the tree of min and max values of consecutive blocks of `GetLeafSize()` Y values.
+    const MinMaxTree& GetTree() const { return tree_; }
+
+    size_t GetLeafSize() const { return leaf_size_; }
+
+private:
+    /// Provides the curve's values to the domain queries (see "plot_domain_query.hpp").
+    struct ValueAccess;
+
+    /// Returns the min and max of valid `y_values_` in [begin_idx, end_idx).
+    MinMax ScanYValues(size_t begin_idx, size_t end_idx) const;
+
+    const double* x_values_;
+    const double* y_values_;
+    const uint8_t* validity_;
+    size_t num_values_;
+    size_t leaf_size_;
+
+    /// Built if requested in `BuildOptions`.
+    XIndex x_index_;
+
+    /// Min and max values of consecutive blocks of `leaf_size_` elements of `y_values_`.
+    MinMaxTree tree_;
+};
+
+} // namespace plot
+
+#endif // PLOT_SPAN_2D_H
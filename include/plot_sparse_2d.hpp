@@ -0,0 +1,149 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_SPARSE_2D_H
+#define PLOT_SPARSE_2D_H
+
+#include "plot_explicit_2d.hpp"
+#include "plot_min_max_tree.hpp"
+#include "plot_value_tree.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace plot {
+
+/// Explicit single-value 2D curve with long gaps (runs of empty Y values), storing only the non-empty values.
+///
+/// The non-empty values are stored as plain `T` with a tree over them, and their runs (separated by gaps) are
+/// indexed, so both the memory and the query time depend on the number of non-empty values and runs, not on
+/// the number of values of the timeline. The ends of a queried interval are located by searching the runs, then
+/// the values of a run. Query results are the same as those of `BasicExplicitSingleValueCurve2D` for the whole
+/// timeline: an interval bound falling into or next to a gap is not interpolated across it.
+///
+/// `BuildOptions::build_x_index` and `BuildOptions::lazy` are ignored.
+///
+/// @tparam T See `BasicExplicitSingleValueCurve2D` (instantiated in "plot_sparse_2d.cpp").
+///
+template<typename T>
+class BasicSparseExplicitSingleValueCurve2D
+{
+public:
+    /// Position of a run of consecutive non-empty values: indices [first_idx, end_idx) of `GetStoredXValues()`.
+    struct Run
+    {
+        size_t first_idx;
+        size_t end_idx;
+    };
+
+    /// Constructor.
+    ///
+    /// @param x_values X values of the timeline; must be strictly increasing.
+    /// @param y_values Y values corresponding to `x_values`; only the non-empty ones are stored.
+    /// @param options Build options of the tree (over the stored values).
+    ///
+    BasicSparseExplicitSingleValueCurve2D(
+        const std::vector<double>& x_values,
+        const std::vector<std::optional<T>>& y_values,
+        const BuildOptions& options = {}
+    );
+
+    /// Returns the number of values of the timeline (i.e. including the empty ones).
+    size_t GetNumValues() const { return num_values_; }
+
+    /// Returns the number of stored (i.e. non-empty) values.
+    size_t GetNumStoredValues() const { return x_values_.size(); }
+
+    /// Returns the runs of consecutive non-empty values, in the order of increasing X.
+    const std::vector<Run>& GetRuns() const { return runs_; }
+
+    /// See `BasicExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval()`.
+    std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(double xmin, double xmax) const;
+
+    /// See `BasicExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval()`.
+    std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(double xmin, double xmax, SearchHint& hint) const;
+
+    /// See `BasicExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`.
+    void GetMinMaxOverDomainColumns(
+        double xmin,
+        double xmax,
+        size_t num_columns,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+    /// See `BasicExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`.
+    void GetMinMaxOverDomainColumns(
+        const std::vector<double>& column_edges,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+    /// See `BasicExplicitSingleValueCurve2D::GetEnvelope()`; the envelope's blocks consist of the stored values.
+    void GetEnvelope(double xmin, double xmax, size_t width, std::vector<EnvelopePoint>& output) const;
+
+    /// Appends a value to the timeline; runs in amortized O(log n) if `y` is not empty, and in O(1) otherwise.
+    ///
+    /// @param x Must be greater than the last X value.
+    ///
+    void Append(double x, const std::optional<T>& y);
+
+    /// Returns the X values of the non-empty values.
+    const std::vector<double>& GetStoredXValues() const { return x_values_; }
+
+    /// Returns the non-empty values.
+    const std::vector<T>& GetStoredYValues() const { return y_values_; }
+
+    /// Returns a number which changes whenever the curve is modified (see `ColumnCache`).
+    size_t GetVersion() const { return num_values_; }
+
+    /// Returns a number identifying the curve; see `BasicValueTree::GetId()`.
+    size_t GetId() const { return id_; }
+
+private:
+    /// Provides the stored values to the domain queries (see "plot_domain_query.hpp").
+    struct ValueAccess;
+
+    /// Returns the min and max of stored values [begin_idx, end_idx).
+    BasicMinMax<T> ScanValues(size_t begin_idx, size_t end_idx) const;
+
+    /// Sets all nodes of `tree_`, resized for `x_values_.size()` values (or more, if it had more leaves).
+    void BuildTree(const std::atomic<bool>* cancel);
+
+    std::vector<double> x_values_;
+
+    std::vector<T> y_values_;
+
+    std::vector<Run> runs_;
+
+    /// Each leaf covers `leaf_size_` consecutive stored values.
+    BasicMinMaxTree<T> tree_;
+
+    size_t leaf_size_;
+
+    unsigned num_threads_;
+
+    size_t id_;
+
+    size_t num_values_{0};
+
+    /// Last X value of the timeline (if it is in a gap, it is not stored).
+    double last_x_{0.0};
+
+    /// True if the last value of the timeline is empty (the next non-empty one starts a new run).
+    bool is_in_gap_{false};
+};
+
+using SparseExplicitSingleValueCurve2D = BasicSparseExplicitSingleValueCurve2D<double>;
+
+} // namespace plot
+
+#endif // PLOT_SPARSE_2D_H
@@ -0,0 +1,48 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_STATS_H
+#define PLOT_STATS_H
+
+#include <cstdint>
+
+namespace plot {
+
+/// Counters of the work done by the queries and tree builds of the calling thread.
+///
+/// Work which a build or query splits among worker threads (see `BuildOptions::num_threads`) is added to
+/// the counters of the thread which called it once the workers finish; `build_time_ns` is the wall time
+/// measured on that thread.
+///
+/// Collected only if the library is built with `PLOT_ENABLE_STATS` (CMake option of the same name);
+/// otherwise the instrumentation compiles to nothing and all counters remain 0.
+///
+struct Stats
+{
+    uint64_t num_queries{0};            ///< Domain interval queries, including one per column of column queries.
+    uint64_t num_search_steps{0};       ///< Comparisons of X values while searching for the bounds of intervals.
+    uint64_t num_interpolations{0};     ///< Y values interpolated at interval bounds.
+    uint64_t num_nodes_visited{0};      ///< Tree nodes read by index interval queries.
+    uint64_t num_leaf_scans{0};         ///< Partially covered leaves scanned by index interval queries.
+    uint64_t num_values_scanned{0};     ///< Values read by those scans.
+    uint64_t num_builds{0};             ///< Trees built (by constructors, `Rebuild()`, or when their capacity is exceeded).
+    uint64_t build_time_ns{0};          ///< Wall time of the tree builds.
+    uint64_t build_bytes{0};            ///< Size of the built trees.
+};
+
+/// Returns the counters of the calling thread.
+const Stats& GetStats();
+
+/// Resets the counters of the calling thread.
+void ResetStats();
+
+} // namespace plot
+
+#endif // PLOT_STATS_H
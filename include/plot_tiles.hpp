@@ -0,0 +1,187 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_TILES_H
+#define PLOT_TILES_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace plot {
+
+/// Division of the X axis into tiles at multiple zoom levels.
+///
+/// At zoom level z, tile k spans [origin + k * w, origin + (k + 1) * w], where w = `base_tile_width` * 2^-z;
+/// each tile consists of `num_columns` equal-width columns. Tile edges, and thus tile contents, do not depend on
+/// which tiles are computed together.
+///
+struct TileGrid
+{
+    double origin{0.0};
+
+    /// Width of a tile at zoom level 0; must be positive.
+    double base_tile_width{1.0};
+
+    /// Number of columns per tile (e.g. the tile's width in pixels); must be positive.
+    size_t num_columns{256};
+
+    /// Returns the X width of a tile at `zoom`.
+    double GetTileWidth(int zoom) const { return std::ldexp(base_tile_width, -zoom); }
+
+    /// Returns the X value of the left edge of column `column` of tile `tile_idx`; `column` may be `num_columns`.
+    double GetColumnEdge(int zoom, int64_t tile_idx, size_t column) const
+    {
+        const double global_column = static_cast<double>(tile_idx) * static_cast<double>(num_columns) + static_cast<double>(column);
+        return origin + global_column * (GetTileWidth(zoom) / static_cast<double>(num_columns));
+    }
+
+    bool operator==(const TileGrid& other) const
+    {
+        return origin == other.origin && base_tile_width == other.base_tile_width && num_columns == other.num_columns;
+    }
+
+    bool operator!=(const TileGrid& other) const { return !(*this == other); }
+};
+
+/// Identifies a tile's contents: the curve, its revision, the grid and the tile's position in it.
+///
+/// Equal keys mean equal tiles only as long as the caller changes `revision` whenever the curve's values change;
+/// then a key can be used for caching (e.g. as a URL).
+///
+struct TileKey
+{
+    /// Identifier of the curve, chosen by the caller (e.g. unique among the curves of a server and stable across restarts).
+    uint64_t curve_id{0};
+
+    /// Revision of the curve's values, chosen by the caller (e.g. a hash of the values, or a revision number
+    /// from where they are stored); must change whenever the values change.
+    ///
+    /// The curves' `GetVersion()` is not suitable if keys outlive the curve object: it restarts from 0
+    /// for each new curve, so a curve rebuilt with other values would get the keys of the old one.
+    ///
+    uint64_t revision{0};
+
+    TileGrid grid;
+
+    int32_t zoom{0};
+
+    int64_t tile_idx{0};
+
+    bool operator==(const TileKey& other) const
+    {
+        return curve_id == other.curve_id && revision == other.revision && grid == other.grid
+            && zoom == other.zoom && tile_idx == other.tile_idx;
+    }
+
+    bool operator!=(const TileKey& other) const { return !(*this == other); }
+
+    /// Returns the key as "<curve_id>/<revision>/<origin>,<base_tile_width>,<num_columns>/<zoom>/<tile_idx>";
+    /// `origin` and `base_tile_width` are written exactly, in hexadecimal floating-point notation (e.g. "0x1.4p+3").
+    std::string ToString() const
+    {
+        char grid_str[96];
+        std::snprintf(grid_str, sizeof(grid_str), "%a,%a,%zu", grid.origin, grid.base_tile_width, grid.num_columns);
+
+        return std::to_string(curve_id) + "/" + std::to_string(revision) + "/" + grid_str
+            + "/" + std::to_string(zoom) + "/" + std::to_string(tile_idx);
+    }
+};
+
+/// Min and max Y values of the columns of a tile.
+struct Tile
+{
+    TileKey key;
+
+    /// Element [i] corresponds to column i; `std::nullopt` if it contains no values.
+    std::vector<std::optional<std::tuple<double, double>>> columns;
+};
+
+/// Computes tiles [first_tile, first_tile + num_tiles) at `zoom` of `curve`.
+///
+/// All the tiles' columns are computed by one call to `curve.GetMinMaxOverDomainColumns()`, i.e. in one left-to-right
+/// pass over the curve. Each column is computed as by `curve.GetMinMaxOverDomainInterval()` over its edges.
+///
+/// @tparam Curve A curve type providing `GetMinMaxOverDomainColumns(column_edges, output)`.
+/// @param curve_id See `TileKey::curve_id`.
+/// @param revision See `TileKey::revision`.
+/// @param output Receives `num_tiles` tiles.
+///
+template<typename Curve>
+void GetTiles(
+    const Curve& curve,
+    uint64_t curve_id,
+    uint64_t revision,
+    const TileGrid& grid,
+    int32_t zoom,
+    int64_t first_tile,
+    size_t num_tiles,
+    std::vector<Tile>& output
+)
+{
+    std::vector<double> edges;
+    edges.reserve(num_tiles * grid.num_columns + 1);
+    for (size_t i = 0; i < num_tiles; ++i)
+    {
+        for (size_t column = 0; column < grid.num_columns; ++column)
+        {
+            edges.push_back(grid.GetColumnEdge(zoom, first_tile + static_cast<int64_t>(i), column));
+        }
+    }
+    edges.push_back(grid.GetColumnEdge(zoom, first_tile + static_cast<int64_t>(num_tiles), 0));
+
+    std::vector<std::optional<std::tuple<double, double>>> columns;
+    if (num_tiles > 0) { curve.GetMinMaxOverDomainColumns(edges, columns); }
+
+    output.resize(num_tiles);
+    for (size_t i = 0; i < num_tiles; ++i)
+    {
+        output[i].key = TileKey{curve_id, revision, grid, zoom, first_tile + static_cast<int64_t>(i)};
+        output[i].columns.assign(columns.begin() + i * grid.num_columns, columns.begin() + (i + 1) * grid.num_columns);
+    }
+}
+
+// Serialized tile format
+// ----------------------
+//
+// Values are stored in the byte order of the machine which wrote them, without padding:
+//
+//   uint32   byte_order_mark     0x01020304
+//   uint64   curve_id
+//   uint64   revision
+//   double   origin              of the tile's grid
+//   double   base_tile_width     of the tile's grid
+//   int32    zoom
+//   int64    tile_idx
+//   uint32   num_columns         C; equal to the grid's `num_columns`
+//   uint8    validity[ceil(C/8)] bit i%8 of byte i/8 is set if column i is not empty
+//   double   min, max            for each non-empty column, in order
+//
+
+/// Serializes `tile` (see the format above); empty columns take 1 bit.
+///
+/// `tile.columns` must have `tile.key.grid.num_columns` elements.
+///
+std::vector<uint8_t> SerializeTile(const Tile& tile);
+
+/// Deserializes a tile written by `SerializeTile()`.
+///
+/// @throws std::runtime_error if `data` is not a valid serialized tile of this machine's byte order.
+///
+Tile DeserializeTile(const uint8_t* data, size_t size);
+
+} // namespace plot
+
+#endif // PLOT_TILES_H
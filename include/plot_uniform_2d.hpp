@@ -0,0 +1,124 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_UNIFORM_2D_H
+#define PLOT_UNIFORM_2D_H
+
+#include "plot_min_max_tree.hpp"
+#include "plot_value_tree.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace plot {
+
+/// Represents an explicit single-value 2D curve sampled at uniformly spaced X values: y = f(x0 + i * dx).
+///
+/// X values are not stored; the index of the value at a given X is computed arithmetically (in O(1))
+/// instead of with a binary search. Otherwise behaves like `ExplicitSingleValueCurve2D`.
+///
+/// @tparam T See `BasicExplicitSingleValueCurve2D`.
+///
+template<typename T>
+class BasicUniformExplicitSingleValueCurve2D
+{
+public:
+    /// Constructor.
+    ///
+    /// @param x0 X value of `y_values[0]`.
+    /// @param dx Distance between consecutive X values; must be positive.
+    /// @param y_values Y values at x0, x0 + dx, x0 + 2 * dx, ...; may be empty.
+    /// @param options Build options; also used when the tree is rebuilt after appending values.
+    ///
+    BasicUniformExplicitSingleValueCurve2D(
+        double x0,
+        double dx,
+        std::shared_ptr<std::vector<std::optional<T>>> y_values,
+        const BuildOptions& options = {}
+    );
+
+    /// Returns the min and max Y value in the interval [xmin, xmax];
+    /// or `std::nullopt` if the interval contains no values.
+    std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(double xmin, double xmax) const;
+
+    /// Returns the min and max Y value for each of `num_columns` equal-width columns spanning [xmin, xmax].
+    ///
+    /// See `ExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns()`.
+    ///
+    void GetMinMaxOverDomainColumns(
+        double xmin,
+        double xmax,
+        size_t num_columns,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+    /// Returns the min and max Y value for each column delimited by `column_edges` (must be non-decreasing).
+    void GetMinMaxOverDomainColumns(
+        const std::vector<double>& column_edges,
+        std::vector<std::optional<std::tuple<double, double>>>& output
+    ) const;
+
+    /// See `BasicExplicitSingleValueCurve2D::GetEnvelope()`.
+    void GetEnvelope(double xmin, double xmax, size_t width, std::vector<EnvelopePoint>& output) const;
+
+    /// Appends a value at the next X value (and to the vector passed to the constructor); runs in amortized O(log n).
+    void Append(const std::optional<T>& y);
+
+    /// Appends values at the next X values (and to the vector passed to the constructor);
+    /// runs in amortized O(k + log n), where k is the number of appended values.
+    void AppendBatch(const std::vector<std::optional<T>>& y_values);
+
+    /// Replaces the Y value at `idx` (in the vector passed to the constructor); runs in O(log n).
+    void SetValue(size_t idx, const std::optional<T>& y) { y_values_.SetValue(idx, y); }
+
+    /// Replaces the Y values starting at `first_idx` (in the vector passed to the constructor) with `y_values`.
+    ///
+    /// Runs in O(k + log n), where k is the number of values; the ancestors shared by the changed leaves
+    /// are updated once.
+    ///
+    void SetRange(size_t first_idx, const std::vector<std::optional<T>>& y_values) { y_values_.SetRange(first_idx, y_values); }
+
+    double GetX0() const { return x0_; }
+    double GetDX() const { return dx_; }
+
+    /// Returns the X value of `GetYValues()[idx]`.
+    double GetX(size_t idx) const { return x0_ + static_cast<double>(idx) * dx_; }
+
+    const std::vector<std::optional<T>>& GetYValues() const { return y_values_.GetValues(); }
+
+    /// Returns the tree of min and max values of consecutive blocks of `GetLeafSize()` Y values.
+    const BasicMinMaxTree<T>& GetTree() const { return y_values_.GetTree(); }
+
+    size_t GetLeafSize() const { return y_values_.GetLeafSize(); }
+
+    /// Returns a number which changes whenever the curve is modified (see `ColumnCache`).
+    size_t GetVersion() const { return y_values_.GetVersion(); }
+
+    /// Returns a number identifying the curve; see `BasicValueTree::GetId()`.
+    size_t GetId() const { return y_values_.GetId(); }
+
+private:
+    /// Provides the curve's values to the domain queries (see "plot_domain_query.hpp").
+    struct ValueAccess;
+
+    double x0_;
+    double dx_;
+
+    BasicValueTree<T> y_values_;
+};
+
+using UniformExplicitSingleValueCurve2D = BasicUniformExplicitSingleValueCurve2D<double>;
+
+} // namespace plot
+
+#endif // PLOT_UNIFORM_2D_H
@@ -0,0 +1,217 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_VALUE_TREE_H
+#define PLOT_VALUE_TREE_H
+
+#include "plot_min_max_tree.hpp"
+
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace plot {
+
+/// Options of building a curve.
+struct BuildOptions
+{
+    /// Number of threads used for validating X values and building the tree; 0 means all hardware threads.
+    ///
+    /// The result does not depend on the number of threads.
+    ///
+    unsigned num_threads{1};
+
+    /// Number of consecutive values covered by each leaf of the tree; must be a power of 2.
+    ///
+    /// Larger leaves make the tree proportionally smaller and faster to build; values in partially covered
+    /// leaves at the ends of a queried interval are scanned directly.
+    ///
+    size_t leaf_size{2};
+
+    /// Allocates the tree; must outlive the curve.
+    ///
+    /// E.g. a `std::pmr::monotonic_buffer_resource` lets many short-lived curves share one buffer.
+    ///
+    std::pmr::memory_resource* memory_resource{std::pmr::get_default_resource()};
+
+    /// If true, curves which support it build an `XIndex` of their X values, which makes searching
+    /// for the ends of queried intervals faster for large numbers of values.
+    bool build_x_index{false};
+
+    /// If true, the tree (and the validation of X values) is deferred until the curve is first queried
+    /// or modified, or until `EnsureBuilt()` is called, e.g. from a background thread to pre-warm the curve.
+    ///
+    /// Curves which are loaded but never displayed then cost neither the build time nor the tree's memory.
+    /// Supported by the curves storing their values in a `BasicValueTree`; ignored by the others.
+    ///
+    bool lazy{false};
+
+    /// If not null, checked periodically while the constructor builds the tree (between layers, and between
+    /// blocks of leaves); once it is true (it must not be reset), the build stops and the constructor throws
+    /// `BuildCancelled`. Lazy builds and later rebuilds are not cancellable.
+    ///
+    /// Supported by the curves storing their values in a `BasicValueTree` (explicit, uniform, ring buffer, aggregate
+    /// and multi-channel), and by `SpanExplicitSingleValueCurve2D`, `BasicSparseExplicitSingleValueCurve2D` and
+    /// `CompressedExplicitSingleValueCurve2D`; ignored by `BasicConcurrentExplicitSingleValueCurve2D`.
+    ///
+    /// See also `BuildAsync()`.
+    ///
+    const std::atomic<bool>* cancel{nullptr};
+};
+
+/// Thrown by a curve's build cancelled with `BuildOptions::cancel`.
+class BuildCancelled: public std::runtime_error
+{
+public:
+    BuildCancelled(): std::runtime_error("curve build cancelled") {}
+};
+
+/// Position of the previous query, passed between queries of one caller (e.g. a panned view) so that each search
+/// starts from the previous one; a query is then O(log d), where d is the distance from the previous interval.
+struct SearchHint
+{
+    size_t idx{0};
+};
+
+/// Point of a min and max envelope of a curve; see `BasicExplicitSingleValueCurve2D::GetEnvelope()`.
+///
+/// A vector of points is a contiguous buffer of (x, min, max) triplets, e.g. for uploading to a GPU as vertex data.
+///
+struct EnvelopePoint
+{
+    double x;
+    double min;
+    double max;
+};
+
+/// Sequence of optional values with a tree of min and max values of their consecutive blocks;
+/// finds the min and max value over an index interval in O(log n).
+///
+/// @tparam T Value type: `double`, `float`, `int32_t` or `int16_t` (instantiated in "plot_value_tree.cpp").
+/// @tparam Aggregation What the tree stores besides min and max (see `BasicMinMaxTree`); with `FullAggregation`,
+///     the queries also return the sum, count, first and last value.
+///
+template<typename T, typename Aggregation = MinMaxAggregation>
+class BasicValueTree
+{
+public:
+    /// Result of the queries: `BasicMinMax<T>`, with the extra values of `Aggregation` if it has any.
+    using Node = TreeNode<T, Aggregation>;
+
+    BasicValueTree(std::shared_ptr<std::vector<std::optional<T>>> values, const BuildOptions& options);
+
+    const std::vector<std::optional<T>>& GetValues() const { return *values_; }
+
+    size_t GetNumValues() const { return values_->size(); }
+
+    /// Returns the tree of min and max values of consecutive blocks of `GetLeafSize()` values.
+    const BasicMinMaxTree<T, Aggregation>& GetTree() const { EnsureBuilt(); return tree_; }
+
+    /// Builds the tree if it was deferred (see `BuildOptions::lazy`); may be called concurrently with queries.
+    void EnsureBuilt() const
+    {
+        if (build_once_) { std::call_once(*build_once_, [this] { BuildTree(); }); }
+    }
+
+    size_t GetLeafSize() const { return options_.leaf_size; }
+
+    const BuildOptions& GetOptions() const { return options_; }
+
+    /// Returns a number which changes whenever the values are modified (e.g. for invalidating cached query results).
+    size_t GetVersion() const { return version_; }
+
+    /// Returns a number identifying this tree (and the curve storing it) among all trees created by the process;
+    /// kept when the tree is moved.
+    ///
+    /// Unlike the tree's address, it is not reused by a tree created after this one is destroyed.
+    ///
+    size_t GetId() const { return id_; }
+
+    /// Appends a value (to the vector passed to the constructor); runs in amortized O(log n).
+    void Append(const std::optional<T>& value);
+
+    /// Appends values (to the vector passed to the constructor); runs in amortized O(k + log n),
+    /// where k is the number of appended values.
+    void AppendBatch(const std::vector<std::optional<T>>& values);
+
+    /// Replaces the value at `idx` (in the vector passed to the constructor); runs in O(log n).
+    void SetValue(size_t idx, const std::optional<T>& value);
+
+    /// Replaces the values starting at `first_idx` (in the vector passed to the constructor) with `values`.
+    ///
+    /// The ancestors shared by the changed leaves are updated once, so the running time is O(k + log n),
+    /// where k is the number of values.
+    ///
+    void SetRange(size_t first_idx, const std::vector<std::optional<T>>& values);
+
+    /// Replaces the values and rebuilds the tree in O(n), reusing its storage if large enough
+    /// (or, if lazy, defers the build again).
+    void Rebuild(std::shared_ptr<std::vector<std::optional<T>>> values);
+
+    /// Returns the min and max value between indices [lo_idx, hi_idx] (empty if the interval contains no values).
+    Node GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx) const;
+
+    /// Returns the min and max of values [block_idx * block_size, (block_idx + 1) * block_size) in O(1)
+    /// (values past the end are ignored).
+    ///
+    /// @param block_size Must be a power of 2.
+    ///
+    Node GetBlockMinMax(size_t block_idx, size_t block_size) const;
+
+private:
+    /// Ensures `tree_` can store at least `num_values`; rebuilds it if its number of leaves changes.
+    void Reserve(size_t num_values);
+
+    /// Sets all nodes of `tree_`; modifies only `tree_` (so that it can be used for the deferred build).
+    void FillTree() const;
+
+    /// Sizes `tree_` for `values_` and fills it.
+    void BuildTree() const;
+
+    /// Returns the min and max of `values_` contained in the leaf `leaf_idx` of `tree_`.
+    Node GetLeafValue(size_t leaf_idx) const;
+
+    /// Updates the leaves of `tree_` containing any of the `values_` in [lo_idx, hi_idx] (and their ancestors).
+    void UpdateLeaves(size_t lo_idx, size_t hi_idx);
+
+    /// Returns the min and max of non-empty `values_` in [begin_idx, end_idx).
+    Node ScanValues(size_t begin_idx, size_t end_idx) const;
+
+    std::shared_ptr<std::vector<std::optional<T>>> values_;
+
+    BuildOptions options_;
+
+    size_t id_;
+
+    size_t version_{0};
+
+    /// Min and max values of consecutive blocks of `options_.leaf_size` elements of `values_`.
+    ///
+    /// Has at least one leaf; leaves past the end of `values_` are empty. Built on first use if lazy (hence `mutable`).
+    ///
+    mutable BasicMinMaxTree<T, Aggregation> tree_;
+
+    /// Guards the deferred build; null if the tree was built by the constructor.
+    ///
+    /// Held by pointer, so that the tree remains movable.
+    ///
+    std::unique_ptr<std::once_flag> build_once_;
+};
+
+using ValueTree = BasicValueTree<double>;
+
+} // namespace plot
+
+#endif // PLOT_VALUE_TREE_H
@@ -0,0 +1,66 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_X_INDEX_H
+#define PLOT_X_INDEX_H
+
+#include <cstddef>
+#include <vector>
+
+namespace plot {
+
+/// Search index of strictly increasing X values: every `SAMPLE_STRIDE`-th value, stored in Eytzinger
+/// (breadth-first) order.
+///
+/// A binary search of the X values themselves touches a different cache line at almost every step.
+/// In Eytzinger order the first steps of all searches read the same few cache lines at the start
+/// of the index, the next steps' candidates are adjacent, and the loop has no data-dependent branches;
+/// the index is 1/`SAMPLE_STRIDE` of the size of the X values, so its upper part stays in the cache.
+/// The search is finished within a block of `SAMPLE_STRIDE` X values (two cache lines).
+///
+class XIndex
+{
+public:
+    /// Number of consecutive X values per sample.
+    static constexpr size_t SAMPLE_STRIDE = 16;
+
+    XIndex() = default;
+
+    /// @param x_values Must be strictly increasing; only read during construction.
+    XIndex(const double* x_values, size_t num_values);
+
+    /// Returns the number of X values covered by the index.
+    size_t GetNumValues() const { return num_values_; }
+
+    /// Returns an index `i` such that all X values before `i` are less than `x`.
+    ///
+    /// If `x` is not greater than the last covered X value, the first X value not less than `x`
+    /// is among [i, i + `SAMPLE_STRIDE`]. X values appended after building the index are not covered;
+    /// for such `x` the result is the last sample.
+    ///
+    size_t GetSearchStart(double x) const;
+
+private:
+    /// Stores samples [first_sample, ...) at the subtree rooted at `node` (1-based); returns the next sample.
+    size_t Build(const double* x_values, size_t node, size_t first_sample);
+
+    /// Returns the position of `node` in the in-order traversal, i.e. the number of samples less than its sample.
+    size_t GetSampleRank(size_t node) const;
+
+    size_t num_values_{0};
+
+    /// Sampled X values in Eytzinger order; node `k` (1-based, stored at `k`) has children `2k` and `2k+1`.
+    /// Element 0 is unused.
+    std::vector<double> samples_;
+};
+
+} // namespace plot
+
+#endif // PLOT_X_INDEX_H
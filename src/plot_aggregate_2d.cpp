@@ -0,0 +1,133 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_aggregate_2d.hpp"
+#include "plot_assert.hpp"
+#include "plot_build.hpp"
+#include "plot_domain_query.hpp"
+
+#include <cstdint>
+
+namespace plot {
+
+/// Converts a node of the curve's tree to the type returned by its queries.
+template<typename T, typename Aggregation>
+static typename BasicAggregateCurve2D<T, Aggregation>::Result ToResult(const TreeNode<T, Aggregation>& node)
+{
+    if constexpr (Aggregation::HAS_EXTRA)
+    {
+        const MinMax min_max = node.IsEmpty() ? MinMax::Empty() : ToMinMax(node);
+        return {min_max.min, min_max.max, node.extra.sum, node.extra.count, node.extra.first, node.extra.last};
+    }
+    else
+    {
+        return node.IsEmpty() ? MinMax::Empty() : ToMinMax(node);
+    }
+}
+
+template<typename T, typename Aggregation>
+BasicAggregateCurve2D<T, Aggregation>::BasicAggregateCurve2D(
+    std::shared_ptr<std::vector<double>> x_values,
+    std::shared_ptr<std::vector<std::optional<T>>> y_values,
+    const BuildOptions& options
+): x_values_(x_values), y_values_(y_values, options)
+{
+    PLOT_ASSERT(x_values_->size() == y_values_.GetNumValues());
+    PLOT_ASSERT(IsStrictlyIncreasing(x_values_->data(), x_values_->size(), options.num_threads));
+}
+
+template<typename T, typename Aggregation>
+struct BasicAggregateCurve2D<T, Aggregation>::ValueAccess
+{
+    const BasicAggregateCurve2D& curve;
+
+    size_t GetNumValues() const { return curve.x_values_->size(); }
+
+    double GetX(size_t idx) const { return (*curve.x_values_)[idx]; }
+};
+
+template<typename T, typename Aggregation>
+void BasicAggregateCurve2D<T, Aggregation>::Append(double x, const std::optional<T>& y)
+{
+    PLOT_ASSERT(x_values_->empty() || x > x_values_->back());
+
+    x_values_->push_back(x);
+    y_values_.Append(y);
+}
+
+template<typename T, typename Aggregation>
+typename BasicAggregateCurve2D<T, Aggregation>::Result BasicAggregateCurve2D<T, Aggregation>::GetAggregateOverIndexInterval(
+    size_t lo_idx,
+    size_t hi_idx
+) const
+{
+    PLOT_ASSERT(lo_idx <= hi_idx && hi_idx < y_values_.GetNumValues());
+
+    return ToResult<T, Aggregation>(y_values_.GetMinMaxOverIndexInterval(lo_idx, hi_idx));
+}
+
+template<typename T, typename Aggregation>
+typename BasicAggregateCurve2D<T, Aggregation>::Result BasicAggregateCurve2D<T, Aggregation>::GetAggregateOverBounds(
+    size_t begin_idx,
+    size_t end_idx
+) const
+{
+    return begin_idx < end_idx ? GetAggregateOverIndexInterval(begin_idx, end_idx - 1) : ToResult<T, Aggregation>(TreeNode<T, Aggregation>::Empty());
+}
+
+template<typename T, typename Aggregation>
+typename BasicAggregateCurve2D<T, Aggregation>::Result BasicAggregateCurve2D<T, Aggregation>::GetAggregateOverDomainInterval(
+    double xmin,
+    double xmax
+) const
+{
+    const ValueAccess values{*this};
+
+    const size_t begin_idx = SearchLowerBound(values, 0, xmin);
+    const size_t end_idx = GetUpperBound(values, xmax, SearchLowerBound(values, 0, xmax));
+
+    return GetAggregateOverBounds(begin_idx, end_idx);
+}
+
+template<typename T, typename Aggregation>
+void BasicAggregateCurve2D<T, Aggregation>::GetAggregateOverDomainColumns(
+    double xmin,
+    double xmax,
+    size_t num_columns,
+    std::vector<Result>& output
+) const
+{
+    output.resize(num_columns);
+    if (num_columns == 0) { return; }
+
+    const ValueAccess values{*this};
+
+    // the values of each column begin where the previous column's end; the search for each edge starts there
+    size_t begin_idx = SearchLowerBound(values, 0, xmin);
+    for (size_t i = 0; i < num_columns; ++i)
+    {
+        const size_t end_idx = (i + 1 == num_columns)
+            ? GetUpperBound(values, xmax, SearchLowerBound(values, begin_idx, xmax))
+            : SearchLowerBound(values, begin_idx, xmin + (xmax - xmin) * (i + 1) / num_columns);
+
+        output[i] = GetAggregateOverBounds(begin_idx, end_idx);
+        begin_idx = end_idx;
+    }
+}
+
+template class BasicAggregateCurve2D<double, MinMaxAggregation>;
+template class BasicAggregateCurve2D<float, MinMaxAggregation>;
+template class BasicAggregateCurve2D<int32_t, MinMaxAggregation>;
+template class BasicAggregateCurve2D<int16_t, MinMaxAggregation>;
+
+template class BasicAggregateCurve2D<double, FullAggregation>;
+template class BasicAggregateCurve2D<float, FullAggregation>;
+template class BasicAggregateCurve2D<int32_t, FullAggregation>;
+template class BasicAggregateCurve2D<int16_t, FullAggregation>;
+
+} // namespace plot
@@ -0,0 +1,28 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_ASSERT_H
+#define PLOT_ASSERT_H
+
+#include <cstdlib>
+#include <iostream>
+
+#define PLOT_ASSERT(condition)                                           \
+{                                                                           \
+    if (!(condition))                                                       \
+    {                                                                       \
+        std::cerr << "Assertion failed at " << __FILE__ << ":" << __LINE__  \
+                  << " inside " << __FUNCTION__ << "\n"                     \
+                  << "Condition: " << #condition << "\n";                   \
+        std::abort();                                                       \
+    }                                                                       \
+}
+
+#endif // PLOT_ASSERT_H
@@ -0,0 +1,109 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_BUILD_H
+#define PLOT_BUILD_H
+
+#include "plot_min_max_tree.hpp"
+#include "plot_parallel.hpp"
+#include "plot_stats_internal.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+// Building blocks shared by the curve types' constructors.
+
+namespace plot {
+
+/// Returns the next curve id (see `BasicValueTree::GetId()`); unique within the process.
+inline size_t GetNewCurveId()
+{
+    static std::atomic<size_t> next_id{0};
+
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// Returns true if `values[0]`...`values[num_values-1]` are strictly increasing.
+inline bool IsStrictlyIncreasing(const double* values, size_t num_values, unsigned num_threads)
+{
+    std::atomic<bool> is_increasing{true};
+    ParallelFor(num_values, num_threads, MIN_VALUES_PER_THREAD, [&](size_t begin, size_t end) {
+        for (size_t i = std::max(begin, size_t{1}); i < end; ++i)
+        {
+            if (!(values[i] > values[i-1])) { is_increasing = false; }
+        }
+    });
+
+    return is_increasing;
+}
+
+/// Returns the min and max of the values contained in the leaf `leaf_idx` (empty past the end of the values).
+///
+/// @param scan Called as `scan(begin_idx, end_idx)`; returns the min and max of values in [begin_idx, end_idx).
+///
+template<typename ScanFunc>
+auto GetLeafMinMax(size_t leaf_idx, size_t num_values, size_t leaf_size, ScanFunc scan)
+{
+    const size_t begin_idx = std::min(leaf_idx * leaf_size, num_values);
+    const size_t end_idx = std::min(begin_idx + leaf_size, num_values);
+
+    return scan(begin_idx, end_idx);
+}
+
+/// Number of leaves set between checks for cancellation.
+constexpr size_t LEAVES_PER_CANCELLATION_CHECK = size_t{1} << 12;
+
+/// Sets all nodes of `tree`, whose leaves contain consecutive blocks of `leaf_size` values.
+///
+/// @param scan See `GetLeafMinMax()`.
+/// @param cancel See `BuildOptions::cancel`.
+/// @return False if cancelled (leaving the nodes partially set).
+///
+template<typename T, typename Aggregation, typename ScanFunc>
+bool FillTree(
+    BasicMinMaxTree<T, Aggregation>& tree,
+    size_t num_values,
+    size_t leaf_size,
+    unsigned num_threads,
+    ScanFunc scan,
+    const std::atomic<bool>* cancel = nullptr
+)
+{
+#if PLOT_ENABLE_STATS
+    const auto start_time = std::chrono::steady_clock::now();
+#endif
+
+    ParallelFor(tree.GetNumLeaves(), num_threads, MIN_VALUES_PER_THREAD / leaf_size, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (cancel && (i - begin) % LEAVES_PER_CANCELLATION_CHECK == 0 && cancel->load(std::memory_order_relaxed)) { return; }
+
+            tree.SetLeaf(i, GetLeafMinMax(i, num_values, leaf_size, scan));
+        }
+    });
+
+    if (!tree.FillInternalNodes(num_threads, cancel)) { return false; }
+
+    PLOT_STATS(
+        Stats& stats = GetThreadStats();
+        ++stats.num_builds;
+        stats.build_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_time).count();
+        stats.build_bytes += tree.GetNumNodes() * tree.NODE_SIZE
+    );
+
+    return true;
+}
+
+} // namespace plot
+
+#endif // PLOT_BUILD_H
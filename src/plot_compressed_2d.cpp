@@ -0,0 +1,302 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_assert.hpp"
+#include "plot_build.hpp"
+#include "plot_compressed_2d.hpp"
+#include "plot_domain_query.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace plot {
+
+// XOR encoding of a block (each block is encoded independently):
+//
+//   first value:   64 bits
+//   each next value, XOR-ed with the previous one:
+//     0                                    XOR is 0 (value repeated)
+//     10 <meaningful bits>                 the XOR's non-zero bits fit in the previous value's window
+//                                          of meaningful bits (same number of leading and trailing zeros or more)
+//     11 <5 bits: L> <6 bits: M - 1> <M>   new window: L leading zeros (at most 31), M meaningful bits
+//
+// Missing values are encoded as NaN.
+
+/// Max. number of leading zeros which can be stored (in 5 bits).
+constexpr unsigned MAX_LEADING_ZEROS = 31;
+
+static uint64_t ToBits(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static double FromBits(uint64_t bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static unsigned CountLeadingZeros(uint64_t value)
+{
+    unsigned count = 0;
+    while (count < 64 && !(value & (uint64_t{1} << (63 - count)))) { ++count; }
+    return count;
+}
+
+static unsigned CountTrailingZeros(uint64_t value)
+{
+    unsigned count = 0;
+    while (count < 64 && !(value & (uint64_t{1} << count))) { ++count; }
+    return count;
+}
+
+/// Appends bits to a vector of words, most significant bit first.
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<uint64_t>& words): words_(words) {}
+
+    size_t GetNumBits() const { return num_bits_; }
+
+    /// Appends the `num_bits` (1-64) lowest bits of `value` (the other bits must be 0).
+    void Write(uint64_t value, unsigned num_bits)
+    {
+        const unsigned offset = num_bits_ % 64;
+        if (offset == 0) { words_.push_back(0); }
+
+        const unsigned num_free = 64 - offset;
+        if (num_bits <= num_free)
+        {
+            words_.back() |= value << (num_free - num_bits);
+        }
+        else
+        {
+            words_.back() |= value >> (num_bits - num_free);
+            words_.push_back(value << (64 - (num_bits - num_free)));
+        }
+        num_bits_ += num_bits;
+    }
+
+private:
+    std::vector<uint64_t>& words_;
+    size_t num_bits_{0};
+};
+
+/// Reads bits written by `BitWriter`.
+class BitReader
+{
+public:
+    BitReader(const uint64_t* words, size_t bit_offset): words_(words), position_(bit_offset) {}
+
+    /// Reads `num_bits` (1-64) bits.
+    uint64_t Read(unsigned num_bits)
+    {
+        const uint64_t* word = words_ + position_ / 64;
+        const unsigned offset = position_ % 64;
+        position_ += num_bits;
+
+        const uint64_t high = (word[0] << offset) >> (64 - num_bits);
+        const unsigned num_available = 64 - offset;
+
+        return num_bits <= num_available ? high : high | (word[1] >> (64 - (num_bits - num_available)));
+    }
+
+    bool ReadBit() { return Read(1) != 0; }
+
+private:
+    const uint64_t* words_;
+    size_t position_;
+};
+
+CompressedExplicitSingleValueCurve2D::CompressedExplicitSingleValueCurve2D(
+    std::shared_ptr<std::vector<double>> x_values,
+    const std::vector<std::optional<double>>& y_values,
+    size_t block_size,
+    const BuildOptions& options
+): x_values_(x_values), block_size_(block_size), tree_(0, options.memory_resource)
+{
+    PLOT_ASSERT(x_values_->size() == y_values.size());
+    PLOT_ASSERT(block_size_ > 0 && (block_size_ & (block_size_ - 1)) == 0);
+    PLOT_ASSERT(IsStrictlyIncreasing(x_values_->data(), x_values_->size(), options.num_threads));
+
+    tree_.ResizeUninitialized(MinMaxTree::GetNumLeavesFor(y_values.size(), block_size_));
+
+    const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    BitWriter writer(bits_);
+    for (size_t block_start = 0; block_start < y_values.size(); block_start += block_size_)
+    {
+        if (options.cancel && block_offsets_.size() % LEAVES_PER_CANCELLATION_CHECK == 0
+            && options.cancel->load(std::memory_order_relaxed))
+        {
+            throw BuildCancelled();
+        }
+
+        block_offsets_.push_back(writer.GetNumBits());
+
+        const size_t block_end = std::min(block_start + block_size_, y_values.size());
+        MinMax min_max = MinMax::Empty();
+
+        uint64_t previous = 0;
+        unsigned leading_zeros = 64; // of the current window; 64 means none yet
+        unsigned trailing_zeros = 0;
+
+        for (size_t i = block_start; i < block_end; ++i)
+        {
+            const double value = y_values[i].value_or(NaN);
+            if (!std::isnan(value)) { min_max.Add(value); }
+
+            const uint64_t bits = ToBits(std::isnan(value) ? NaN : value);
+            if (i == block_start)
+            {
+                writer.Write(bits, 64);
+            }
+            else if (const uint64_t x = bits ^ previous; x == 0)
+            {
+                writer.Write(0, 1);
+            }
+            else
+            {
+                const unsigned lz = std::min(CountLeadingZeros(x), MAX_LEADING_ZEROS);
+                const unsigned tz = CountTrailingZeros(x);
+
+                if (leading_zeros < 64 && lz >= leading_zeros && tz >= trailing_zeros)
+                {
+                    writer.Write(0b10, 2);
+                    writer.Write(x >> trailing_zeros, 64 - leading_zeros - trailing_zeros);
+                }
+                else
+                {
+                    const unsigned num_meaningful = 64 - lz - tz;
+                    writer.Write(0b11, 2);
+                    writer.Write(lz, 5);
+                    writer.Write(num_meaningful - 1, 6);
+                    writer.Write(x >> tz, num_meaningful);
+
+                    leading_zeros = lz;
+                    trailing_zeros = tz;
+                }
+            }
+            previous = bits;
+        }
+
+        tree_.SetLeaf(block_start / block_size_, min_max);
+    }
+
+    for (size_t i = block_offsets_.size(); i < tree_.GetNumLeaves(); ++i)
+    {
+        tree_.SetLeaf(i, MinMax::Empty());
+    }
+    if (!tree_.FillInternalNodes(options.num_threads, options.cancel)) { throw BuildCancelled(); }
+
+    // so that reading the last word's successor (see `BitReader::Read()`) stays within the vector
+    bits_.push_back(0);
+}
+
+template<typename Func>
+void CompressedExplicitSingleValueCurve2D::DecodeBlock(size_t begin_idx, size_t end_idx, Func func) const
+{
+    const size_t block_start = begin_idx / block_size_ * block_size_;
+    BitReader reader(bits_.data(), block_offsets_[block_start / block_size_]);
+
+    uint64_t bits = reader.Read(64);
+    unsigned leading_zeros = 0;
+    unsigned trailing_zeros = 0;
+
+    for (size_t i = block_start; i < end_idx; ++i)
+    {
+        if (i > block_start && reader.ReadBit())
+        {
+            if (reader.ReadBit())
+            {
+                leading_zeros = static_cast<unsigned>(reader.Read(5));
+                trailing_zeros = 64 - leading_zeros - (static_cast<unsigned>(reader.Read(6)) + 1);
+            }
+            bits ^= reader.Read(64 - leading_zeros - trailing_zeros) << trailing_zeros;
+        }
+
+        if (i >= begin_idx) { func(i, FromBits(bits)); }
+    }
+}
+
+std::optional<double> CompressedExplicitSingleValueCurve2D::GetY(size_t idx) const
+{
+    double result = 0.0;
+    DecodeBlock(idx, idx + 1, [&](size_t, double value) { result = value; });
+
+    return std::isnan(result) ? std::nullopt : std::optional<double>(result);
+}
+
+MinMax CompressedExplicitSingleValueCurve2D::ScanBlock(size_t begin_idx, size_t end_idx) const
+{
+    MinMax result = MinMax::Empty();
+    if (begin_idx < end_idx)
+    {
+        // `std::min` and `std::max` with the accumulator first skip NaNs
+        DecodeBlock(begin_idx, end_idx, [&](size_t, double value) {
+            result.min = std::min(result.min, value);
+            result.max = std::max(result.max, value);
+        });
+    }
+
+    return result;
+}
+
+struct CompressedExplicitSingleValueCurve2D::ValueAccess
+{
+    const CompressedExplicitSingleValueCurve2D& curve;
+
+    size_t GetNumValues() const { return curve.x_values_->size(); }
+
+    double GetX(size_t idx) const { return (*curve.x_values_)[idx]; }
+
+    std::optional<double> GetY(size_t idx) const { return curve.GetY(idx); }
+
+    size_t LowerBound(double x, size_t start_idx) const { return SearchLowerBound(*this, start_idx, x); }
+
+    MinMax GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx) const
+    {
+        return plot::GetMinMaxOverIndexInterval(
+            curve.tree_.GetView(),
+            curve.block_size_,
+            lo_idx,
+            hi_idx,
+            [this](size_t begin_idx, size_t end_idx) { return curve.ScanBlock(begin_idx, end_idx); }
+        );
+    }
+};
+
+std::optional<std::tuple<double, double>> CompressedExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval(double xmin, double xmax) const
+{
+    return plot::GetMinMaxOverDomainInterval(ValueAccess{*this}, xmin, xmax);
+}
+
+void CompressedExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns(
+    double xmin,
+    double xmax,
+    size_t num_columns,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(ValueAccess{*this}, xmin, xmax, num_columns, output);
+}
+
+void CompressedExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns(
+    const std::vector<double>& column_edges,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(ValueAccess{*this}, column_edges, output);
+}
+
+} // namespace plot
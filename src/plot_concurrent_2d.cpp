@@ -0,0 +1,197 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_assert.hpp"
+#include "plot_build.hpp"
+#include "plot_concurrent_2d.hpp"
+#include "plot_domain_query.hpp"
+#include "plot_scan.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace plot {
+
+template<typename T>
+BasicConcurrentExplicitSingleValueCurve2D<T>::BasicConcurrentExplicitSingleValueCurve2D(
+    const BuildOptions& options,
+    size_t initial_capacity
+): options_(options)
+{
+    PLOT_ASSERT(options_.leaf_size > 0 && (options_.leaf_size & (options_.leaf_size - 1)) == 0);
+
+    Grow(std::max(initial_capacity, options_.leaf_size));
+}
+
+template<typename T>
+void BasicConcurrentExplicitSingleValueCurve2D<T>::Grow(size_t capacity)
+{
+    auto buffers = std::make_unique<Buffers>();
+
+    const size_t num_leaves = BasicMinMaxTree<T>::GetNumLeavesFor(capacity, options_.leaf_size);
+    buffers->capacity = num_leaves * options_.leaf_size;
+    buffers->x_values = std::make_unique<double[]>(buffers->capacity);
+    buffers->y_values = std::make_unique<std::optional<T>[]>(buffers->capacity);
+    buffers->tree = BasicMinMaxTree<T>(0, options_.memory_resource);
+    buffers->tree.ResizeUninitialized(num_leaves); // filled below
+
+    size_t num_values = 0;
+    if (!buffers_.empty())
+    {
+        // only the writer modifies the buffers, so there is no need for synchronization here
+        const Buffers& old = *buffers_.front();
+        num_values = old.num_values.load(std::memory_order_relaxed);
+        std::copy(old.x_values.get(), old.x_values.get() + num_values, buffers->x_values.get());
+        std::copy(old.y_values.get(), old.y_values.get() + num_values, buffers->y_values.get());
+    }
+
+    const std::optional<T>* y_values = buffers->y_values.get();
+    FillTree(buffers->tree, num_values, options_.leaf_size, options_.num_threads, [&](size_t begin_idx, size_t end_idx) {
+        return ScanMinMax(y_values + begin_idx, end_idx - begin_idx);
+    });
+
+    buffers->num_values.store(num_values, std::memory_order_relaxed);
+
+    // publishes the buffers' contents along with the pointer
+    current_.store(buffers.get(), std::memory_order_release);
+    buffers_.insert(buffers_.begin(), std::move(buffers));
+}
+
+template<typename T>
+void BasicConcurrentExplicitSingleValueCurve2D<T>::Append(double x, const std::optional<T>& y)
+{
+    const size_t num_values = buffers_.front()->num_values.load(std::memory_order_relaxed);
+    if (num_values == buffers_.front()->capacity)
+    {
+        Grow(2 * num_values);
+    }
+
+    Buffers& buffers = *buffers_.front();
+    PLOT_ASSERT(num_values == 0 || x > buffers.x_values[num_values - 1]);
+
+    buffers.x_values[num_values] = x;
+    buffers.y_values[num_values] = y;
+
+    // Queries over [0, num_values) do not read this leaf (it is incomplete) nor its ancestors (they span
+    // this leaf too); see `GetMinMaxOverIndexInterval()` in "plot_domain_query.hpp".
+    const size_t leaf = num_values / options_.leaf_size;
+    const size_t first_idx = leaf * options_.leaf_size;
+    buffers.tree.SetLeaf(leaf, ScanMinMax(buffers.y_values.get() + first_idx, num_values + 1 - first_idx));
+    buffers.tree.UpdateAncestors(leaf, leaf);
+
+    buffers.num_values.store(num_values + 1, std::memory_order_release);
+}
+
+template<typename T>
+struct BasicConcurrentExplicitSingleValueCurve2D<T>::ValueAccess
+{
+    const Buffers& buffers;
+    size_t num_values;
+    size_t leaf_size;
+
+    size_t GetNumValues() const { return num_values; }
+
+    double GetX(size_t idx) const { return buffers.x_values[idx]; }
+
+    std::optional<double> GetY(size_t idx) const
+    {
+        const std::optional<T>& y = buffers.y_values[idx];
+        return y.has_value() ? std::optional<double>(*y) : std::nullopt;
+    }
+
+    size_t LowerBound(double x, size_t start_idx) const { return SearchLowerBound(*this, start_idx, x); }
+
+    BasicMinMax<T> ScanYValues(size_t begin_idx, size_t end_idx) const
+    {
+        return ScanMinMax(buffers.y_values.get() + begin_idx, end_idx - begin_idx);
+    }
+
+    MinMax GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx) const
+    {
+        return ToMinMax(plot::GetMinMaxOverIndexInterval(
+            buffers.tree.GetView(),
+            leaf_size,
+            lo_idx,
+            hi_idx,
+            [this](size_t begin_idx, size_t end_idx) { return ScanYValues(begin_idx, end_idx); }
+        ));
+    }
+
+    MinMax GetBlockMinMax(size_t block_idx, size_t block_size) const
+    {
+        // the last blocks may extend past `num_values`; their nodes are not read, as they may be being updated
+        const size_t begin_idx = std::min(block_idx * block_size, num_values);
+        const size_t end_idx = std::min(begin_idx + block_size, num_values);
+
+        if (begin_idx == end_idx)
+        {
+            return MinMax::Empty();
+        }
+        else if (block_size >= leaf_size && end_idx - begin_idx == block_size)
+        {
+            return ToMinMax(buffers.tree.GetBlock(block_idx, block_size / leaf_size));
+        }
+        else
+        {
+            return GetMinMaxOverIndexInterval(begin_idx, end_idx - 1);
+        }
+    }
+};
+
+template<typename T>
+typename BasicConcurrentExplicitSingleValueCurve2D<T>::ValueAccess BasicConcurrentExplicitSingleValueCurve2D<T>::GetPublishedValues() const
+{
+    const Buffers* buffers = current_.load(std::memory_order_acquire);
+
+    return ValueAccess{*buffers, buffers->num_values.load(std::memory_order_acquire), options_.leaf_size};
+}
+
+template<typename T>
+size_t BasicConcurrentExplicitSingleValueCurve2D<T>::GetNumValues() const
+{
+    return GetPublishedValues().GetNumValues();
+}
+
+template<typename T>
+std::optional<std::tuple<double, double>> BasicConcurrentExplicitSingleValueCurve2D<T>::GetMinMaxOverDomainInterval(double xmin, double xmax) const
+{
+    return plot::GetMinMaxOverDomainInterval(GetPublishedValues(), xmin, xmax);
+}
+
+template<typename T>
+void BasicConcurrentExplicitSingleValueCurve2D<T>::GetMinMaxOverDomainColumns(
+    double xmin,
+    double xmax,
+    size_t num_columns,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(GetPublishedValues(), xmin, xmax, num_columns, output);
+}
+
+template<typename T>
+void BasicConcurrentExplicitSingleValueCurve2D<T>::GetMinMaxOverDomainColumns(
+    const std::vector<double>& column_edges,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(GetPublishedValues(), column_edges, output);
+}
+
+template<typename T>
+void BasicConcurrentExplicitSingleValueCurve2D<T>::GetEnvelope(double xmin, double xmax, size_t width, std::vector<EnvelopePoint>& output) const
+{
+    plot::GetEnvelope(GetPublishedValues(), xmin, xmax, width, output);
+}
+
+template class BasicConcurrentExplicitSingleValueCurve2D<double>;
+template class BasicConcurrentExplicitSingleValueCurve2D<float>;
+template class BasicConcurrentExplicitSingleValueCurve2D<int32_t>;
+template class BasicConcurrentExplicitSingleValueCurve2D<int16_t>;
+
+} // namespace plot
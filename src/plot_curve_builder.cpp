@@ -0,0 +1,180 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_curve_builder.hpp"
+#include "plot_parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <tuple>
+
+namespace plot {
+
+template<typename T>
+void BasicExplicitCurveBuilder<T>::AddChunk(std::vector<double> x_values, std::vector<std::optional<T>> y_values)
+{
+    if (x_values.size() != y_values.size())
+    {
+        throw InvalidCurveData("numbers of X and Y values differ", chunks_.size(), std::min(x_values.size(), y_values.size()));
+    }
+
+    chunks_.push_back(Chunk{std::move(x_values), std::move(y_values), {}});
+}
+
+template<typename T>
+std::optional<InvalidCurveData> BasicExplicitCurveBuilder<T>::PrepareChunk(Chunk& chunk, size_t chunk_idx, DuplicateX duplicates)
+{
+    const std::vector<double>& x = chunk.x_values;
+
+    bool is_increasing = true;
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        if (!std::isfinite(x[i])) { return InvalidCurveData("X value is not finite", chunk_idx, i); }
+        if (i > 0 && !(x[i] > x[i-1])) { is_increasing = false; }
+    }
+    if (is_increasing) { return std::nullopt; }
+
+    chunk.order.resize(x.size());
+    std::iota(chunk.order.begin(), chunk.order.end(), size_t{0});
+    std::stable_sort(chunk.order.begin(), chunk.order.end(), [&](size_t a, size_t b) { return x[a] < x[b]; });
+
+    // remove duplicates; the stable sort keeps values with equal X in the order they were added
+    size_t num_kept = 0;
+    for (size_t i = 0; i < chunk.order.size(); ++i)
+    {
+        const size_t idx = chunk.order[i];
+        if (num_kept > 0 && x[idx] == x[chunk.order[num_kept - 1]])
+        {
+            switch (duplicates)
+            {
+            case DuplicateX::Reject: return InvalidCurveData("X value is repeated", chunk_idx, idx);
+            case DuplicateX::KeepFirst: break;
+            case DuplicateX::KeepLast: chunk.order[num_kept - 1] = idx; break;
+            }
+        }
+        else
+        {
+            chunk.order[num_kept++] = idx;
+        }
+    }
+    chunk.order.resize(num_kept);
+
+    return std::nullopt;
+}
+
+template<typename T>
+BasicExplicitSingleValueCurve2D<T> BasicExplicitCurveBuilder<T>::Build(const BuildOptions& options)
+{
+    std::vector<Chunk> chunks = std::move(chunks_);
+    chunks_.clear();
+
+    std::vector<std::optional<InvalidCurveData>> errors(chunks.size());
+    ParallelFor(chunks.size(), options.num_threads, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) { errors[i] = PrepareChunk(chunks[i], i, duplicates_); }
+    });
+    for (auto& error: errors)
+    {
+        if (error.has_value()) { throw *error; }
+    }
+
+    // non-empty chunks, ordered by their first X value
+    std::vector<size_t> sorted_chunks;
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        if (chunks[i].GetSize() > 0) { sorted_chunks.push_back(i); }
+    }
+    const auto first_x = [&](size_t i) { return chunks[i].x_values[chunks[i].GetIndex(0)]; };
+    const auto last_x  = [&](size_t i) { return chunks[i].x_values[chunks[i].GetIndex(chunks[i].GetSize() - 1)]; };
+    std::stable_sort(sorted_chunks.begin(), sorted_chunks.end(), [&](size_t a, size_t b) { return first_x(a) < first_x(b); });
+
+    bool are_disjoint = true;
+    for (size_t i = 1; i < sorted_chunks.size(); ++i)
+    {
+        if (!(first_x(sorted_chunks[i]) > last_x(sorted_chunks[i - 1]))) { are_disjoint = false; }
+    }
+
+    auto x_values = std::make_shared<std::vector<double>>();
+    auto y_values = std::make_shared<std::vector<std::optional<T>>>();
+
+    if (sorted_chunks.size() == 1 && chunks[sorted_chunks[0]].order.empty())
+    {
+        *x_values = std::move(chunks[sorted_chunks[0]].x_values);
+        *y_values = std::move(chunks[sorted_chunks[0]].y_values);
+    }
+    else if (are_disjoint)
+    {
+        std::vector<size_t> offsets(sorted_chunks.size() + 1, 0);
+        for (size_t i = 0; i < sorted_chunks.size(); ++i) { offsets[i + 1] = offsets[i] + chunks[sorted_chunks[i]].GetSize(); }
+
+        x_values->resize(offsets.back());
+        y_values->resize(offsets.back());
+        ParallelFor(sorted_chunks.size(), options.num_threads, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const Chunk& chunk = chunks[sorted_chunks[i]];
+                for (size_t j = 0; j < chunk.GetSize(); ++j)
+                {
+                    (*x_values)[offsets[i] + j] = chunk.x_values[chunk.GetIndex(j)];
+                    (*y_values)[offsets[i] + j] = chunk.y_values[chunk.GetIndex(j)];
+                }
+            }
+        });
+    }
+    else
+    {
+        size_t num_values = 0;
+        for (const auto& chunk: chunks) { num_values += chunk.GetSize(); }
+        x_values->reserve(num_values);
+        y_values->reserve(num_values);
+
+        // (X value, chunk index, position in the chunk's order); ties are taken in chunk order
+        using Head = std::tuple<double, size_t, size_t>;
+        std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+        for (size_t i: sorted_chunks) { heads.emplace(first_x(i), i, 0); }
+
+        while (!heads.empty())
+        {
+            const auto [x, chunk_idx, position] = heads.top();
+            heads.pop();
+
+            const Chunk& chunk = chunks[chunk_idx];
+            const size_t idx = chunk.GetIndex(position);
+            if (position + 1 < chunk.GetSize()) { heads.emplace(chunk.x_values[chunk.GetIndex(position + 1)], chunk_idx, position + 1); }
+
+            if (!x_values->empty() && x == x_values->back())
+            {
+                switch (duplicates_)
+                {
+                case DuplicateX::Reject: throw InvalidCurveData("X value is repeated", chunk_idx, idx);
+                case DuplicateX::KeepFirst: break;
+                case DuplicateX::KeepLast: y_values->back() = chunk.y_values[idx]; break;
+                }
+            }
+            else
+            {
+                x_values->push_back(x);
+                y_values->push_back(chunk.y_values[idx]);
+            }
+        }
+    }
+
+    // merged in order with duplicates removed, so strictly increasing (and finite)
+    return BasicExplicitSingleValueCurve2D<T>(x_values, y_values, options, true);
+}
+
+template class BasicExplicitCurveBuilder<double>;
+template class BasicExplicitCurveBuilder<float>;
+template class BasicExplicitCurveBuilder<int32_t>;
+template class BasicExplicitCurveBuilder<int16_t>;
+
+} // namespace plot
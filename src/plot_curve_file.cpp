@@ -0,0 +1,286 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_curve_file.hpp"
+#include "plot_domain_query.hpp"
+#include "plot_scan.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace plot {
+
+static constexpr char MAGIC[8] = { 'P', 'L', 'O', 'T', 'C', 'R', 'V', '\0' };
+
+static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+static constexpr uint64_t SECTION_ALIGNMENT = 64;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order_mark;
+    uint64_t num_values;
+    uint64_t leaf_size;
+    uint64_t num_leaves;
+    uint64_t x_offset;
+    uint64_t y_offset;
+    uint64_t validity_offset;
+    uint64_t tree_min_offset;
+    uint64_t tree_max_offset;
+};
+
+static_assert(sizeof(FileHeader) == 80);
+
+static uint64_t AlignSection(uint64_t offset)
+{
+    return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+static uint64_t GetValidityLength(uint64_t num_values)
+{
+    return (num_values + 7) / 8;
+}
+
+void WriteCurveFile(const ExplicitSingleValueCurve2D& curve, const std::string& path)
+{
+    const auto& x_values = curve.GetXValues();
+    const auto& y_values = curve.GetYValues();
+    const MinMaxTreeView tree = curve.GetTree().GetView();
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = CURVE_FILE_VERSION;
+    header.byte_order_mark = BYTE_ORDER_MARK;
+    header.num_values = x_values.size();
+    header.leaf_size = curve.GetLeafSize();
+    header.num_leaves = tree.GetNumLeaves();
+    header.x_offset = AlignSection(sizeof(FileHeader));
+    header.y_offset = AlignSection(header.x_offset + header.num_values * sizeof(double));
+    header.validity_offset = AlignSection(header.y_offset + header.num_values * sizeof(double));
+    header.tree_min_offset = AlignSection(header.validity_offset + GetValidityLength(header.num_values));
+    header.tree_max_offset = AlignSection(header.tree_min_offset + tree.GetNumNodes() * sizeof(double));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) { throw std::runtime_error("cannot create curve file " + path); }
+
+    const auto write = [&](uint64_t offset, const void* data, size_t length) {
+        // pad up to the section's offset
+        const char padding[SECTION_ALIGNMENT]{};
+        file.write(padding, offset - static_cast<uint64_t>(file.tellp()));
+        file.write(static_cast<const char*>(data), length);
+    };
+
+    write(0, &header, sizeof(header));
+    write(header.x_offset, x_values.data(), x_values.size() * sizeof(double));
+
+    // Y values and validity bits are converted in chunks
+    constexpr size_t CHUNK_SIZE = 1 << 16;
+    std::vector<double> y_chunk;
+    std::vector<uint8_t> validity_chunk;
+
+    for (size_t chunk_start = 0; chunk_start < y_values.size(); chunk_start += CHUNK_SIZE)
+    {
+        const size_t chunk_end = std::min(chunk_start + CHUNK_SIZE, y_values.size());
+        y_chunk.clear();
+        for (size_t i = chunk_start; i < chunk_end; ++i) { y_chunk.push_back(y_values[i].value_or(0.0)); }
+        write(header.y_offset + chunk_start * sizeof(double), y_chunk.data(), y_chunk.size() * sizeof(double));
+    }
+
+    for (size_t chunk_start = 0; chunk_start < y_values.size(); chunk_start += CHUNK_SIZE)
+    {
+        const size_t chunk_end = std::min(chunk_start + CHUNK_SIZE, y_values.size());
+        validity_chunk.assign(GetValidityLength(chunk_end - chunk_start), 0);
+        for (size_t i = chunk_start; i < chunk_end; ++i)
+        {
+            if (y_values[i].has_value()) { validity_chunk[(i - chunk_start) / 8] |= 1 << ((i - chunk_start) % 8); }
+        }
+        write(header.validity_offset + chunk_start / 8, validity_chunk.data(), validity_chunk.size());
+    }
+
+    write(header.tree_min_offset, tree.GetMinValues(), tree.GetNumNodes() * sizeof(double));
+    write(header.tree_max_offset, tree.GetMaxValues(), tree.GetNumNodes() * sizeof(double));
+
+    file.close();
+    if (!file) { throw std::runtime_error("cannot write curve file " + path); }
+}
+
+struct MappedExplicitSingleValueCurve2D::ValueAccess
+{
+    const MappedExplicitSingleValueCurve2D& curve;
+
+    size_t GetNumValues() const { return curve.num_values_; }
+
+    double GetX(size_t idx) const { return curve.x_values_[idx]; }
+
+    std::optional<double> GetY(size_t idx) const
+    {
+        if ((curve.validity_[idx / 8] >> (idx % 8)) & 1)
+        {
+            return curve.y_values_[idx];
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+    size_t LowerBound(double x, size_t start_idx) const { return SearchLowerBound(*this, start_idx, x); }
+
+    MinMax GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx) const
+    {
+        return plot::GetMinMaxOverIndexInterval(
+            curve.tree_,
+            curve.leaf_size_,
+            lo_idx,
+            hi_idx,
+            [this](size_t begin_idx, size_t end_idx) {
+                return ScanMinMax(curve.y_values_, curve.validity_, begin_idx, end_idx);
+            }
+        );
+    }
+};
+
+MappedExplicitSingleValueCurve2D::MappedExplicitSingleValueCurve2D(const std::string& path)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) { throw std::runtime_error("cannot open curve file " + path); }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || static_cast<uint64_t>(file_stat.st_size) < sizeof(FileHeader))
+    {
+        close(fd);
+        throw std::runtime_error("invalid curve file " + path);
+    }
+
+    mapping_size_ = file_stat.st_size;
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping_ == MAP_FAILED)
+    {
+        mapping_ = nullptr;
+        throw std::runtime_error("cannot map curve file " + path);
+    }
+
+    const auto fail = [&](const char* reason) {
+        Unmap();
+        throw std::runtime_error("invalid curve file " + path + ": " + reason);
+    };
+
+    FileHeader header;
+    std::memcpy(&header, mapping_, sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) { fail("bad magic"); }
+    if (header.byte_order_mark != BYTE_ORDER_MARK) { fail("different byte order"); }
+    if (header.version != CURVE_FILE_VERSION) { fail("unsupported version"); }
+
+    const bool is_leaf_size_valid = header.leaf_size > 0 && (header.leaf_size & (header.leaf_size - 1)) == 0 &&
+        header.leaf_size <= (uint64_t{1} << 58);
+    const bool is_num_leaves_valid = header.num_leaves > 0 && (header.num_leaves & (header.num_leaves - 1)) == 0 &&
+        header.num_leaves <= (uint64_t{1} << 58);
+    if (!is_leaf_size_valid || !is_num_leaves_valid || header.num_values > (uint64_t{1} << 58) ||
+        (header.num_values + header.leaf_size - 1) / header.leaf_size > header.num_leaves)
+    {
+        fail("bad size");
+    }
+
+    const uint64_t num_nodes = 2 * header.num_leaves - 1;
+    const auto section_fits = [&](uint64_t offset, uint64_t length) {
+        return offset % sizeof(double) == 0 && offset <= mapping_size_ && length <= mapping_size_ - offset;
+    };
+    if (!section_fits(header.x_offset, header.num_values * sizeof(double)) ||
+        !section_fits(header.y_offset, header.num_values * sizeof(double)) ||
+        !section_fits(header.validity_offset, GetValidityLength(header.num_values)) ||
+        !section_fits(header.tree_min_offset, num_nodes * sizeof(double)) ||
+        !section_fits(header.tree_max_offset, num_nodes * sizeof(double)))
+    {
+        fail("bad section offset");
+    }
+
+    const uint8_t* base = static_cast<const uint8_t*>(mapping_);
+    num_values_ = header.num_values;
+    leaf_size_ = header.leaf_size;
+    x_values_ = reinterpret_cast<const double*>(base + header.x_offset);
+    y_values_ = reinterpret_cast<const double*>(base + header.y_offset);
+    validity_ = base + header.validity_offset;
+    tree_ = MinMaxTreeView(
+        header.num_leaves,
+        reinterpret_cast<const double*>(base + header.tree_min_offset),
+        reinterpret_cast<const double*>(base + header.tree_max_offset)
+    );
+}
+
+MappedExplicitSingleValueCurve2D::~MappedExplicitSingleValueCurve2D()
+{
+    Unmap();
+}
+
+MappedExplicitSingleValueCurve2D::MappedExplicitSingleValueCurve2D(MappedExplicitSingleValueCurve2D&& other)
+{
+    *this = std::move(other);
+}
+
+MappedExplicitSingleValueCurve2D& MappedExplicitSingleValueCurve2D::operator=(MappedExplicitSingleValueCurve2D&& other)
+{
+    if (this != &other)
+    {
+        Unmap();
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mapping_size_ = std::exchange(other.mapping_size_, 0);
+        num_values_ = std::exchange(other.num_values_, 0);
+        leaf_size_ = other.leaf_size_;
+        x_values_ = other.x_values_;
+        y_values_ = other.y_values_;
+        validity_ = other.validity_;
+        tree_ = other.tree_;
+    }
+
+    return *this;
+}
+
+void MappedExplicitSingleValueCurve2D::Unmap()
+{
+    if (mapping_ != nullptr)
+    {
+        munmap(mapping_, mapping_size_);
+        mapping_ = nullptr;
+    }
+}
+
+std::optional<std::tuple<double, double>> MappedExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval(double xmin, double xmax) const
+{
+    return plot::GetMinMaxOverDomainInterval(ValueAccess{*this}, xmin, xmax);
+}
+
+void MappedExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns(
+    double xmin,
+    double xmax,
+    size_t num_columns,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(ValueAccess{*this}, xmin, xmax, num_columns, output);
+}
+
+void MappedExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns(
+    const std::vector<double>& column_edges,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(ValueAccess{*this}, column_edges, output);
+}
+
+} // namespace plot
@@ -0,0 +1,540 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_DOMAIN_QUERY_H
+#define PLOT_DOMAIN_QUERY_H
+
+#include "plot_min_max_tree.hpp"
+#include "plot_stats_internal.hpp"
+#include "plot_value_tree.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Domain queries shared by the curve types. They are implemented in terms of a `Values` type providing:
+//
+//   size_t GetNumValues() const;
+//   double GetX(size_t idx) const;                 // X values are strictly increasing
+//   std::optional<double> GetY(size_t idx) const;
+//   size_t LowerBound(double x, size_t start_idx) const;
+//                                                  // index of the first X value not less than `x`; the caller
+//                                                  // guarantees the result is not less than `start_idx`
+//   MinMax GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx) const;
+//
+// and, for `GetEnvelope()`:
+//
+//   MinMax GetBlockMinMax(size_t block_idx, size_t block_size) const;  // see `BasicValueTree::GetBlockMinMax()`
+//
+// Values which do not store their empty Y values may also provide:
+//
+//   bool IsGapBefore(size_t idx) const;            // true if there were empty Y values between `idx - 1` and `idx`
+//
+// so that nothing is interpolated across the gap (see `BasicSparseExplicitSingleValueCurve2D`).
+//
+
+namespace plot {
+
+/// Returns `compare(a, b)` if both values are present, otherwise the present one (if any).
+///
+/// @tparam Compare Comparator policy, e.g. `MinOf`.
+///
+template<typename Compare>
+std::optional<double> GetOneOf(const std::optional<double>& a, const std::optional<double>& b, Compare compare)
+{
+    if (a.has_value() && b.has_value())
+    {
+        return compare(*a, *b);
+    }
+    else if (a.has_value())
+    {
+        return *a;
+    }
+    else if (b.has_value())
+    {
+        return *b;
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
+inline std::optional<std::tuple<double, double>> GetMinMax(const std::optional<double>& a, const std::optional<double>& b)
+{
+    if (a.has_value() && b.has_value())
+    {
+        return std::make_tuple(std::min(*a, *b), std::max(*a, *b));
+    }
+    else if (a.has_value())
+    {
+        return std::make_tuple(*a, *a);
+    }
+    else if (b.has_value())
+    {
+        return std::make_tuple(*b, *b);
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
+inline std::optional<std::tuple<double, double>> ToOptional(const MinMax& min_max)
+{
+    if (min_max.IsEmpty())
+    {
+        return std::nullopt;
+    }
+    else
+    {
+        return std::make_tuple(min_max.min, min_max.max);
+    }
+}
+
+/// Returns the min and max of values [lo_idx, hi_idx] stored in blocks of `leaf_size` as the leaves of `tree`
+/// (with the extra values of `Aggregation`, combined in sequence order).
+///
+/// @param scan Called as `scan(begin_idx, end_idx)`; returns the min and max (the tree's `Node`) of values
+///     in [begin_idx, end_idx). Used for the values not forming a whole leaf at the ends of the interval.
+///
+template<typename T, typename Aggregation, typename ScanFunc>
+TreeNode<T, Aggregation> GetMinMaxOverIndexInterval(
+    const BasicMinMaxTreeView<T, Aggregation>& tree,
+    size_t leaf_size,
+    size_t lo_idx,
+    size_t hi_idx,
+    ScanFunc scan
+)
+{
+    using Node = TreeNode<T, Aggregation>;
+
+    size_t first_leaf = lo_idx / leaf_size;
+    size_t end_leaf = hi_idx / leaf_size + 1;
+
+    if (first_leaf + 1 == end_leaf && (lo_idx % leaf_size != 0 || (hi_idx + 1) % leaf_size != 0))
+    {
+        PLOT_STATS(++GetThreadStats().num_leaf_scans; GetThreadStats().num_values_scanned += hi_idx + 1 - lo_idx);
+        return scan(lo_idx, hi_idx + 1);
+    }
+
+    Node result = Node::Empty();
+    if (lo_idx % leaf_size != 0)
+    {
+        PLOT_STATS(++GetThreadStats().num_leaf_scans; GetThreadStats().num_values_scanned += (first_leaf + 1) * leaf_size - lo_idx);
+        result.Add(scan(lo_idx, (first_leaf + 1) * leaf_size));
+        ++first_leaf;
+    }
+
+    Node right = Node::Empty();
+    if ((hi_idx + 1) % leaf_size != 0)
+    {
+        --end_leaf;
+        PLOT_STATS(++GetThreadStats().num_leaf_scans; GetThreadStats().num_values_scanned += hi_idx + 1 - end_leaf * leaf_size);
+        right = scan(end_leaf * leaf_size, hi_idx + 1);
+    }
+
+    if (end_leaf > first_leaf)
+    {
+        result.Add(tree.GetMinMaxOverLeafInterval(first_leaf, end_leaf - 1));
+    }
+    result.Add(right);
+
+    return result;
+}
+
+/// Returns the min and max of values [block_idx * block_size, (block_idx + 1) * block_size) in O(1), where
+/// `num_values` values are stored in blocks of `leaf_size` as the leaves of `tree` (values past the end are ignored).
+///
+/// @param block_size Must be a power of 2.
+/// @param scan See `GetMinMaxOverIndexInterval()`; used for blocks smaller than a leaf.
+///
+template<typename T, typename Aggregation, typename ScanFunc>
+TreeNode<T, Aggregation> GetTreeBlockMinMax(
+    const BasicMinMaxTreeView<T, Aggregation>& tree,
+    size_t num_values,
+    size_t leaf_size,
+    size_t block_idx,
+    size_t block_size,
+    ScanFunc scan
+)
+{
+    using Node = TreeNode<T, Aggregation>;
+
+    if (block_size < leaf_size)
+    {
+        const size_t begin_idx = std::min(block_idx * block_size, num_values);
+        const size_t end_idx = std::min(begin_idx + block_size, num_values);
+        return scan(begin_idx, end_idx);
+    }
+
+    const size_t block_leaves = block_size / leaf_size;
+    if (block_leaves >= tree.GetNumLeaves())
+    {
+        return block_idx == 0 ? tree.GetNode(0) : Node::Empty();
+    }
+    else if ((block_idx + 1) * block_leaves > tree.GetNumLeaves())
+    {
+        return Node::Empty();
+    }
+    else
+    {
+        return tree.GetBlock(block_idx, block_leaves);
+    }
+}
+
+/// Returns the index of the first X value in [lo_idx, hi_idx) which is not less than `x`, or `hi_idx` if none is.
+template<typename Values>
+size_t BinaryLowerBound(const Values& values, size_t lo_idx, size_t hi_idx, double x)
+{
+    size_t lo = lo_idx;
+    size_t hi = hi_idx;
+    while (lo < hi)
+    {
+        PLOT_STATS(++GetThreadStats().num_search_steps);
+
+        const size_t middle = lo + (hi - lo) / 2;
+        if (values.GetX(middle) < x) { lo = middle + 1; } else { hi = middle; }
+    }
+
+    return lo;
+}
+
+/// Returns the index of the first X value (starting at `start_idx`) which is not less than `x`.
+///
+/// Searches with exponentially increasing steps first, so that the cost is logarithmic in the distance
+/// from `start_idx` to the result rather than in the number of values.
+///
+template<typename Values>
+size_t GallopingLowerBound(const Values& values, size_t start_idx, double x)
+{
+    const size_t num_values = values.GetNumValues();
+
+    size_t lo = start_idx;
+    size_t step = 1;
+    while (lo + step < num_values && values.GetX(lo + step) < x)
+    {
+        PLOT_STATS(++GetThreadStats().num_search_steps);
+
+        lo += step;
+        step *= 2;
+    }
+
+    // the result is in [lo, hi]
+    return BinaryLowerBound(values, lo, std::min(lo + step, num_values), x);
+}
+
+/// Implements `Values::LowerBound()` for values with X stored in an array: a binary search of all values
+/// if `start_idx` is 0, otherwise a galloping search from `start_idx`.
+template<typename Values>
+size_t SearchLowerBound(const Values& values, size_t start_idx, double x)
+{
+    if (start_idx == 0)
+    {
+        return BinaryLowerBound(values, 0, values.GetNumValues(), x);
+    }
+    else
+    {
+        return GallopingLowerBound(values, start_idx, x);
+    }
+}
+
+/// Returns the index of the first X value which is not less than `x`, searching in both directions from `hint_idx`.
+///
+/// The cost is logarithmic in the distance from `hint_idx` to the result.
+///
+template<typename Values>
+size_t FingerLowerBound(const Values& values, size_t hint_idx, double x)
+{
+    const size_t num_values = values.GetNumValues();
+    if (hint_idx < num_values && values.GetX(hint_idx) < x)
+    {
+        return GallopingLowerBound(values, hint_idx, x);
+    }
+
+    // the result is not after `hi`
+    size_t hi = std::min(hint_idx, num_values);
+    size_t step = 1;
+    while (hi >= step && !(values.GetX(hi - step) < x))
+    {
+        PLOT_STATS(++GetThreadStats().num_search_steps);
+
+        hi -= step;
+        step *= 2;
+    }
+
+    return BinaryLowerBound(values, hi >= step ? hi - step : 0, hi, x);
+}
+
+/// Returns the index of the first X value greater than `x`, given `lo_idx` - the index of the first X value not less than `x`.
+template<typename Values>
+size_t GetUpperBound(const Values& values, double x, size_t lo_idx)
+{
+    // X values are strictly increasing
+    return (lo_idx < values.GetNumValues() && values.GetX(lo_idx) == x) ? lo_idx + 1 : lo_idx;
+}
+
+/// True if `Values` provides `IsGapBefore()`.
+template<typename Values, typename = void>
+struct HasGaps: std::false_type {};
+
+template<typename Values>
+struct HasGaps<Values, std::void_t<decltype(std::declval<const Values&>().IsGapBefore(size_t{0}))>>: std::true_type {};
+
+/// Returns the value interpolated at `x` if `x` falls strictly between two X values having non-empty Y values
+/// (and no gap of empty Y values not stored, see `HasGaps`).
+///
+/// @param lo_idx Index of the first X value not less than `x`.
+///
+template<typename Values>
+std::optional<double> GetInterpolatedValue(const Values& values, double x, size_t lo_idx)
+{
+    if (lo_idx == 0 || lo_idx >= values.GetNumValues()) { return std::nullopt; }
+
+    if constexpr (HasGaps<Values>::value)
+    {
+        if (values.IsGapBefore(lo_idx)) { return std::nullopt; }
+    }
+
+    const double x_hi = values.GetX(lo_idx);
+    if (!(x_hi > x)) { return std::nullopt; }
+
+    const std::optional<double> y_lo = values.GetY(lo_idx - 1);
+    const std::optional<double> y_hi = values.GetY(lo_idx);
+    if (!y_lo.has_value() || !y_hi.has_value()) { return std::nullopt; }
+
+    const double x_lo = values.GetX(lo_idx - 1);
+
+    PLOT_STATS(++GetThreadStats().num_interpolations);
+
+    return *y_lo + (x - x_lo) / (x_hi - x_lo) * (*y_hi - *y_lo);
+}
+
+/// Returns the min and max Y value in the interval [xmin, xmax] given the results of searching the X values.
+///
+/// @param lo_idx Index of the first X value not less than `xmin`.
+/// @param hi_bound Index of the first X value greater than `xmax`.
+/// @param lo_interp Interpolated Y value at `xmin` (if any).
+/// @param hi_interp Interpolated Y value at `xmax` (if any).
+///
+template<typename Values>
+std::optional<std::tuple<double, double>> GetMinMaxOverBounds(
+    const Values& values,
+    size_t lo_idx,
+    size_t hi_bound,
+    const std::optional<double>& lo_interp,
+    const std::optional<double>& hi_interp
+)
+{
+    if (lo_idx == values.GetNumValues()) { return std::nullopt; }
+    if (hi_bound == 0) { return std::nullopt; }
+
+    const size_t hi_idx = hi_bound - 1;
+
+    std::optional<std::tuple<double, double>> min_max_inside_interval;
+
+    if (hi_idx >= lo_idx) // if there are any X values between (xmin, xmax)
+    {
+        min_max_inside_interval = ToOptional(values.GetMinMaxOverIndexInterval(lo_idx, hi_idx));
+    }
+
+    if (min_max_inside_interval.has_value())
+    {
+        const auto min_interp = GetOneOf(lo_interp, hi_interp, MinOf{});
+        const auto max_interp = GetOneOf(lo_interp, hi_interp, MaxOf{});
+
+        const auto actual_min = GetOneOf(min_interp, std::get<0>(*min_max_inside_interval), MinOf{});
+        const auto actual_max = GetOneOf(max_interp, std::get<1>(*min_max_inside_interval), MaxOf{});
+
+        if (actual_min.has_value() && actual_max.has_value())
+        {
+            return std::make_tuple(*actual_min, *actual_max);
+        }
+        else if (actual_min.has_value())
+        {
+            return std::make_tuple(*actual_min, *actual_min);
+        }
+        else if (actual_max.has_value())
+        {
+            return std::make_tuple(*actual_max, *actual_max);
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+    else
+    {
+        return GetMinMax(lo_interp, hi_interp);
+    }
+}
+
+/// Returns the min and max Y value in the interval [xmin, xmax].
+///
+/// @param lo_idx Index of the first X value not less than `xmin`.
+/// @param hi_search_start Index not greater than that of the first X value not less than `xmax`.
+///
+template<typename Values>
+std::optional<std::tuple<double, double>> GetMinMaxOverDomainIntervalFrom(
+    const Values& values,
+    size_t lo_idx,
+    size_t hi_search_start,
+    double xmin,
+    double xmax
+)
+{
+    PLOT_STATS(++GetThreadStats().num_queries);
+
+    const size_t hi_lower_bound = values.LowerBound(xmax, hi_search_start);
+    const size_t hi_bound = GetUpperBound(values, xmax, hi_lower_bound);
+
+    return GetMinMaxOverBounds(
+        values,
+        lo_idx,
+        hi_bound,
+        GetInterpolatedValue(values, xmin, lo_idx),
+        GetInterpolatedValue(values, xmax, hi_lower_bound)
+    );
+}
+
+/// Returns the min and max Y value in the interval [xmin, xmax]; or `std::nullopt` if the interval contains no values.
+template<typename Values>
+std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(const Values& values, double xmin, double xmax)
+{
+    // the searches are independent: galloping from `xmin` to a distant `xmax` would take more steps than a binary search
+    return GetMinMaxOverDomainIntervalFrom(values, values.LowerBound(xmin, 0), 0, xmin, xmax);
+}
+
+/// Same as `GetMinMaxOverDomainInterval()`, but searches for `xmin` from `hint` (which is then set to the result),
+/// and for `xmax` from `xmin`; suited for the narrow intervals of a zoomed-in view.
+template<typename Values>
+std::optional<std::tuple<double, double>> GetMinMaxOverDomainInterval(const Values& values, double xmin, double xmax, SearchHint& hint)
+{
+    hint.idx = FingerLowerBound(values, hint.idx, xmin);
+    return GetMinMaxOverDomainIntervalFrom(values, hint.idx, xmax >= xmin ? hint.idx : 0, xmin, xmax);
+}
+
+/// Returns the min and max Y value for each column [column_edge(i), column_edge(i + 1)], i = 0...num_columns-1.
+///
+/// @param column_edge Returns the column edges; must be non-decreasing.
+///
+template<typename Values, typename EdgeFunc>
+void GetMinMaxOverColumns(
+    const Values& values,
+    size_t num_columns,
+    EdgeFunc column_edge,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+)
+{
+    output.resize(num_columns);
+    if (num_columns == 0) { return; }
+
+    PLOT_STATS(GetThreadStats().num_queries += num_columns);
+
+    // Each column edge is searched for and interpolated at only once; the results serve both as the upper bound
+    // of the column to the left and the lower bound of the column to the right.
+
+    double edge = column_edge(0);
+    size_t lo_idx = values.LowerBound(edge, 0);
+    std::optional<double> interp = GetInterpolatedValue(values, edge, lo_idx);
+
+    for (size_t i = 0; i < num_columns; ++i)
+    {
+        const double next_edge = column_edge(i + 1);
+        const size_t next_lo_idx = values.LowerBound(next_edge, lo_idx);
+        const std::optional<double> next_interp = GetInterpolatedValue(values, next_edge, next_lo_idx);
+
+        output[i] = GetMinMaxOverBounds(values, lo_idx, GetUpperBound(values, next_edge, next_lo_idx), interp, next_interp);
+
+        lo_idx = next_lo_idx;
+        interp = next_interp;
+    }
+}
+
+/// Returns the min and max Y value for each of `num_columns` equal-width columns spanning [xmin, xmax].
+template<typename Values>
+void GetMinMaxOverDomainColumns(
+    const Values& values,
+    double xmin,
+    double xmax,
+    size_t num_columns,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+)
+{
+    GetMinMaxOverColumns(
+        values,
+        num_columns,
+        [=](size_t i) { return i == num_columns ? xmax : xmin + (xmax - xmin) * i / num_columns; },
+        output
+    );
+}
+
+/// Returns the min and max Y value for each column delimited by `column_edges`.
+template<typename Values>
+void GetMinMaxOverDomainColumns(
+    const Values& values,
+    const std::vector<double>& column_edges,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+)
+{
+    GetMinMaxOverColumns(
+        values,
+        column_edges.empty() ? 0 : column_edges.size() - 1,
+        [&](size_t i) { return column_edges[i]; },
+        output
+    );
+}
+
+/// Returns the min and max envelope of the values in [xmin, xmax] at a resolution of about `width` columns.
+///
+/// The values are divided into aligned blocks of 2^k values, the largest not exceeding the number of values
+/// per column, so that each block is a single node of the tree and the running time is O(width), regardless
+/// of the number of values. The blocks at the ends may include values outside [xmin, xmax].
+///
+/// @param output Receives one point (at the middle of its first and last X value) per non-empty block,
+///     in the order of increasing X; at most about 2 * `width` + 2 points.
+///
+template<typename Values>
+void GetEnvelope(const Values& values, double xmin, double xmax, size_t width, std::vector<EnvelopePoint>& output)
+{
+    output.clear();
+    if (width == 0) { return; }
+
+    const size_t lo_idx = values.LowerBound(xmin, 0);
+    const size_t hi_bound = GetUpperBound(values, xmax, values.LowerBound(xmax, 0));
+    if (hi_bound <= lo_idx) { return; }
+
+    const size_t values_per_column = (hi_bound - lo_idx) / width;
+    size_t block_size = 1;
+    while (block_size * 2 <= values_per_column) { block_size *= 2; }
+
+    const size_t first_block = lo_idx / block_size;
+    const size_t last_block = (hi_bound - 1) / block_size;
+    output.reserve(last_block - first_block + 1);
+
+    for (size_t block = first_block; block <= last_block; ++block)
+    {
+        const MinMax min_max = values.GetBlockMinMax(block, block_size);
+        if (min_max.IsEmpty()) { continue; }
+
+        const size_t first_idx = block * block_size;
+        const size_t last_idx = std::min(first_idx + block_size, values.GetNumValues()) - 1;
+
+        output.push_back({0.5 * (values.GetX(first_idx) + values.GetX(last_idx)), min_max.min, min_max.max});
+    }
+}
+
+} // namespace plot
+
+#endif // PLOT_DOMAIN_QUERY_H
@@ -0,0 +1,300 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_assert.hpp"
+#include "plot_min_max_tree.hpp"
+#include "plot_parallel.hpp"
+#include "plot_stats_internal.hpp"
+
+#include <cstdint>
+#include <utility>
+
+namespace plot {
+
+template<typename T, typename Aggregation>
+BasicMinMaxTree<T, Aggregation>::BasicMinMaxTree(size_t num_leaves, std::pmr::memory_resource* resource)
+: resource_(resource)
+{
+    PLOT_ASSERT(resource_ != nullptr);
+
+    ResizeUninitialized(num_leaves);
+    std::fill(min_, min_ + GetNumNodes(), MinMax::Empty().min);
+    std::fill(max_, max_ + GetNumNodes(), MinMax::Empty().max);
+    if constexpr (Aggregation::HAS_EXTRA) { std::fill(extra_, extra_ + GetNumNodes(), Aggregation::EmptyExtra()); }
+}
+
+template<typename T, typename Aggregation>
+BasicMinMaxTree<T, Aggregation>::~BasicMinMaxTree()
+{
+    Deallocate();
+}
+
+template<typename T, typename Aggregation>
+BasicMinMaxTree<T, Aggregation>::BasicMinMaxTree(BasicMinMaxTree&& other)
+{
+    *this = std::move(other);
+}
+
+template<typename T, typename Aggregation>
+BasicMinMaxTree<T, Aggregation>& BasicMinMaxTree<T, Aggregation>::operator=(BasicMinMaxTree&& other)
+{
+    if (this != &other)
+    {
+        Deallocate();
+
+        num_leaves_ = other.num_leaves_;
+        capacity_ = other.capacity_;
+        resource_ = other.resource_;
+        storage_ = other.storage_;
+        min_ = other.min_;
+        max_ = other.max_;
+        extra_ = other.extra_;
+
+        other.num_leaves_ = 0;
+        other.capacity_ = 0;
+        other.storage_ = nullptr;
+        other.min_ = nullptr;
+        other.max_ = nullptr;
+        other.extra_ = nullptr;
+    }
+
+    return *this;
+}
+
+template<typename T, typename Aggregation>
+void BasicMinMaxTree<T, Aggregation>::Deallocate()
+{
+    if (storage_ != nullptr)
+    {
+        resource_->deallocate(storage_, GetStorageSize(2 * capacity_ - 1), STORAGE_ALIGNMENT);
+        storage_ = nullptr;
+    }
+}
+
+template<typename T, typename Aggregation>
+void BasicMinMaxTree<T, Aggregation>::ResizeUninitialized(size_t num_leaves)
+{
+    PLOT_ASSERT((num_leaves & (num_leaves - 1)) == 0);
+
+    if (num_leaves > capacity_)
+    {
+        Deallocate();
+
+        // `T` is an arithmetic type and `Extra` is trivially copyable, so the storage can be used
+        // without constructing its elements
+        const size_t num_nodes = 2 * num_leaves - 1;
+        storage_ = resource_->allocate(GetStorageSize(num_nodes), STORAGE_ALIGNMENT);
+        capacity_ = num_leaves;
+        min_ = static_cast<T*>(storage_);
+        max_ = min_ + num_nodes;
+        if constexpr (Aggregation::HAS_EXTRA)
+        {
+            extra_ = reinterpret_cast<Extra*>(static_cast<char*>(storage_) + GetExtraOffset(num_nodes));
+        }
+    }
+
+    num_leaves_ = num_leaves;
+}
+
+template<typename T, typename Aggregation>
+size_t BasicMinMaxTree<T, Aggregation>::GetNumLeavesFor(size_t num_values, size_t leaf_size)
+{
+    const size_t num_needed = num_values / leaf_size + (num_values % leaf_size != 0 ? 1 : 0);
+
+    // so that the number of nodes (2L - 1) and the 1-based node numbers used in queries (< 2L) do not overflow
+    constexpr size_t MAX_NUM_LEAVES = (std::numeric_limits<size_t>::max() >> 2) + 1;
+    PLOT_ASSERT(num_needed <= MAX_NUM_LEAVES);
+
+    size_t num_leaves = 1;
+    while (num_leaves < num_needed) { num_leaves *= 2; }
+
+    return num_leaves;
+}
+
+/// Min. number of leaves in a subtree filled by a separate thread.
+constexpr size_t MIN_LEAVES_PER_THREAD = size_t{1} << 14;
+
+template<typename T, typename Aggregation>
+bool BasicMinMaxTree<T, Aggregation>::FillInternalNodes(unsigned num_threads, const std::atomic<bool>* cancel)
+{
+    // Layer `l` consists of nodes [2^l - 1, 2^(l+1) - 1); the leaves form layer `k` (L = 2^k).
+    //
+    // The tree is split into 2^d subtrees rooted at layer `d`. Within each subtree, layers are filled from
+    // the lowest one; the subtree's nodes in layer `l` are 2^(l-d) consecutive nodes. Afterwards, layers
+    // above `d` are filled serially.
+
+    int k = 0;
+    while ((size_t{1} << k) < num_leaves_) { ++k; }
+
+    int d = 0;
+    while ((size_t{1} << d) < GetNumThreads(num_threads) && (num_leaves_ >> (d + 1)) >= MIN_LEAVES_PER_THREAD) { ++d; }
+
+    ParallelFor(size_t{1} << d, num_threads, 1, [&](size_t first_subtree, size_t end_subtree) {
+        for (size_t subtree = first_subtree; subtree < end_subtree; ++subtree)
+        {
+            for (int layer = k - 1; layer >= d; --layer)
+            {
+                if (cancel && cancel->load(std::memory_order_relaxed)) { return; }
+
+                const size_t num_subtree_nodes = size_t{1} << (layer - d);
+                const size_t first_node = (size_t{1} << layer) - 1 + subtree * num_subtree_nodes;
+                for (size_t i = first_node + num_subtree_nodes; i > first_node; --i)
+                {
+                    UpdateNode(i - 1);
+                }
+            }
+        }
+    });
+
+    // the flag is never reset, so it is still set if any thread stopped early
+    if (cancel && cancel->load(std::memory_order_relaxed)) { return false; }
+
+    for (size_t i = (size_t{1} << d) - 1; i > 0; --i)
+    {
+        UpdateNode(i - 1);
+    }
+
+    return true;
+}
+
+template<typename T, typename Aggregation>
+void BasicMinMaxTree<T, Aggregation>::UpdateAncestors(size_t first_leaf, size_t last_leaf)
+{
+    size_t first = num_leaves_ - 1 + first_leaf;
+    size_t last = num_leaves_ - 1 + last_leaf;
+
+    while (first > 0)
+    {
+        first = (first - 1) / 2;
+        last = (last - 1) / 2;
+        for (size_t i = first; i <= last; ++i)
+        {
+            UpdateNode(i);
+        }
+    }
+}
+
+template<typename T, typename Aggregation>
+typename BasicMinMaxTreeView<T, Aggregation>::Node BasicMinMaxTreeView<T, Aggregation>::GetMinMaxOverLeafInterval(size_t first_leaf, size_t last_leaf) const
+{
+    // Uses 1-based node numbering (node `n` is stored at index n-1), in which the leaves are [L, 2L),
+    // the parent of `n` is n/2, and left children are even.
+    //
+    // [lo, hi) is the half-open interval of nodes still to be accounted for at the current layer. If `lo` is
+    // a right child, its parent spans leaves outside the interval, so `lo` is taken as is (same for `hi - 1`
+    // being a left child); then both move up one layer.
+
+    // with extra values, nodes taken at the right end precede the ones taken there before, so they are
+    // accumulated separately; min and max alone do not depend on the order
+
+    Node result = Node::Empty();
+    Node right = Node::Empty();
+
+    size_t lo = num_leaves_ + first_leaf;
+    size_t hi = num_leaves_ + last_leaf + 1;
+    while (lo < hi)
+    {
+        if (lo & 1)
+        {
+            PLOT_STATS(++GetThreadStats().num_nodes_visited);
+            if constexpr (Aggregation::HAS_EXTRA)
+            {
+                result.Add(GetNode(lo - 1));
+            }
+            else
+            {
+                result.min = std::min(result.min, min_[lo - 1]);
+                result.max = std::max(result.max, max_[lo - 1]);
+            }
+            ++lo;
+        }
+        if (hi & 1)
+        {
+            PLOT_STATS(++GetThreadStats().num_nodes_visited);
+            --hi;
+            if constexpr (Aggregation::HAS_EXTRA)
+            {
+                Node node = GetNode(hi - 1);
+                node.Add(right);
+                right = node;
+            }
+            else
+            {
+                result.min = std::min(result.min, min_[hi - 1]);
+                result.max = std::max(result.max, max_[hi - 1]);
+            }
+        }
+        lo >>= 1;
+        hi >>= 1;
+    }
+
+    if constexpr (Aggregation::HAS_EXTRA) { result.Add(right); }
+
+    return result;
+}
+
+template<typename T, typename Aggregation>
+typename BasicMinMaxTreeView<T, Aggregation>::Node BasicMinMaxTreeView<T, Aggregation>::GetMinMaxOverLeafIntervalRecursive(size_t first_leaf, size_t last_leaf) const
+{
+    return GetMinMaxOverLeafIntervalRecursive(first_leaf, last_leaf, 0, 0, num_leaves_ - 1);
+}
+
+template<typename T, typename Aggregation>
+typename BasicMinMaxTreeView<T, Aggregation>::Node BasicMinMaxTreeView<T, Aggregation>::GetMinMaxOverLeafIntervalRecursive(
+    size_t first_leaf,
+    size_t last_leaf,
+    size_t node_idx,
+    size_t node_first,
+    size_t node_last
+) const
+{
+    if (first_leaf == node_first && last_leaf == node_last)
+    {
+        return GetNode(node_idx);
+    }
+
+    // first leaf of the second child
+    const size_t middle = node_first + (node_last - node_first + 1) / 2;
+
+    if (last_leaf < middle)
+    {
+        return GetMinMaxOverLeafIntervalRecursive(first_leaf, last_leaf, 2 * node_idx + 1, node_first, middle - 1);
+    }
+    else if (first_leaf >= middle)
+    {
+        return GetMinMaxOverLeafIntervalRecursive(first_leaf, last_leaf, 2 * node_idx + 2, middle, node_last);
+    }
+    else
+    {
+        Node result = GetMinMaxOverLeafIntervalRecursive(first_leaf, middle - 1, 2 * node_idx + 1, node_first, middle - 1);
+        result.Add(GetMinMaxOverLeafIntervalRecursive(middle, last_leaf, 2 * node_idx + 2, middle, node_last));
+        return result;
+    }
+}
+
+template class BasicMinMaxTreeView<double, MinMaxAggregation>;
+template class BasicMinMaxTreeView<float, MinMaxAggregation>;
+template class BasicMinMaxTreeView<int32_t, MinMaxAggregation>;
+template class BasicMinMaxTreeView<int16_t, MinMaxAggregation>;
+
+template class BasicMinMaxTreeView<double, FullAggregation>;
+template class BasicMinMaxTreeView<float, FullAggregation>;
+template class BasicMinMaxTreeView<int32_t, FullAggregation>;
+template class BasicMinMaxTreeView<int16_t, FullAggregation>;
+
+template class BasicMinMaxTree<double, MinMaxAggregation>;
+template class BasicMinMaxTree<float, MinMaxAggregation>;
+template class BasicMinMaxTree<int32_t, MinMaxAggregation>;
+template class BasicMinMaxTree<int16_t, MinMaxAggregation>;
+
+template class BasicMinMaxTree<double, FullAggregation>;
+template class BasicMinMaxTree<float, FullAggregation>;
+template class BasicMinMaxTree<int32_t, FullAggregation>;
+template class BasicMinMaxTree<int16_t, FullAggregation>;
+
+} // namespace plot
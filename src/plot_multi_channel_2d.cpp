@@ -0,0 +1,198 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_assert.hpp"
+#include "plot_build.hpp"
+#include "plot_domain_query.hpp"
+#include "plot_multi_channel_2d.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+namespace plot {
+
+template<typename T>
+BasicMultiChannelCurve2D<T>::BasicMultiChannelCurve2D(
+    std::shared_ptr<std::vector<double>> x_values,
+    const std::vector<std::shared_ptr<std::vector<std::optional<T>>>>& channels,
+    const BuildOptions& options
+): x_values_(x_values)
+{
+    PLOT_ASSERT(IsStrictlyIncreasing(x_values_->data(), x_values_->size(), options.num_threads));
+
+    channels_.reserve(channels.size());
+    for (const auto& y_values: channels)
+    {
+        PLOT_ASSERT(y_values->size() == x_values_->size());
+        channels_.emplace_back(y_values, options);
+    }
+
+    all_channels_.resize(channels_.size());
+    std::iota(all_channels_.begin(), all_channels_.end(), size_t{0});
+}
+
+template<typename T>
+void BasicMultiChannelCurve2D<T>::Append(double x, const std::vector<std::optional<T>>& y_values)
+{
+    PLOT_ASSERT(y_values.size() == channels_.size());
+    PLOT_ASSERT(x_values_->empty() || x > x_values_->back());
+
+    x_values_->push_back(x);
+    for (size_t i = 0; i < channels_.size(); ++i)
+    {
+        channels_[i].Append(y_values[i]);
+    }
+}
+
+template<typename T>
+struct BasicMultiChannelCurve2D<T>::ValueAccess
+{
+    const BasicMultiChannelCurve2D& curve;
+
+    /// Not accessed by the X value searches, which are shared by all channels.
+    size_t channel;
+
+    size_t GetNumValues() const { return curve.x_values_->size(); }
+
+    double GetX(size_t idx) const { return (*curve.x_values_)[idx]; }
+
+    std::optional<double> GetY(size_t idx) const
+    {
+        const std::optional<T>& y = curve.channels_[channel].GetValues()[idx];
+        return y.has_value() ? std::optional<double>(*y) : std::nullopt;
+    }
+
+    size_t LowerBound(double x, size_t start_idx) const { return SearchLowerBound(*this, start_idx, x); }
+
+    MinMax GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx) const
+    {
+        return ToMinMax(curve.channels_[channel].GetMinMaxOverIndexInterval(lo_idx, hi_idx));
+    }
+};
+
+/// Stores `min_max` (empty if `std::nullopt`) at `idx` of `output`.
+static void SetResult(MultiChannelMinMax& output, size_t idx, const std::optional<std::tuple<double, double>>& min_max)
+{
+    const MinMax result = min_max.has_value() ? MinMax{std::get<0>(*min_max), std::get<1>(*min_max)} : MinMax::Empty();
+    output.min[idx] = result.min;
+    output.max[idx] = result.max;
+}
+
+template<typename T>
+void BasicMultiChannelCurve2D<T>::GetMinMaxOverDomainInterval(double xmin, double xmax, MultiChannelMinMax& output) const
+{
+    GetMinMaxOverDomainInterval(xmin, xmax, all_channels_, output);
+}
+
+template<typename T>
+void BasicMultiChannelCurve2D<T>::GetMinMaxOverDomainInterval(
+    double xmin,
+    double xmax,
+    const std::vector<size_t>& channels,
+    MultiChannelMinMax& output
+) const
+{
+    output.num_columns = 1;
+    output.min.resize(channels.size());
+    output.max.resize(channels.size());
+
+    const ValueAccess x_access{*this, 0};
+    const size_t lo_idx = x_access.LowerBound(xmin, 0);
+    const size_t hi_lower_bound = x_access.LowerBound(xmax, 0);
+    const size_t hi_bound = GetUpperBound(x_access, xmax, hi_lower_bound);
+
+    for (size_t r = 0; r < channels.size(); ++r)
+    {
+        PLOT_ASSERT(channels[r] < channels_.size());
+
+        const ValueAccess values{*this, channels[r]};
+        SetResult(output, r, GetMinMaxOverBounds(
+            values,
+            lo_idx,
+            hi_bound,
+            GetInterpolatedValue(values, xmin, lo_idx),
+            GetInterpolatedValue(values, xmax, hi_lower_bound)
+        ));
+    }
+}
+
+template<typename T>
+void BasicMultiChannelCurve2D<T>::GetMinMaxOverDomainColumns(
+    double xmin,
+    double xmax,
+    size_t num_columns,
+    MultiChannelMinMax& output,
+    MultiChannelScratch* scratch
+) const
+{
+    GetMinMaxOverDomainColumns(xmin, xmax, num_columns, all_channels_, output, scratch);
+}
+
+template<typename T>
+void BasicMultiChannelCurve2D<T>::GetMinMaxOverDomainColumns(
+    double xmin,
+    double xmax,
+    size_t num_columns,
+    const std::vector<size_t>& channels,
+    MultiChannelMinMax& output,
+    MultiChannelScratch* scratch
+) const
+{
+    output.num_columns = num_columns;
+    output.min.resize(channels.size() * num_columns);
+    output.max.resize(channels.size() * num_columns);
+    if (num_columns == 0) { return; }
+
+    // As in `GetMinMaxOverColumns()`, but the column edges are searched for once for all channels;
+    // each channel only interpolates at the edges and queries its tree.
+
+    const auto column_edge = [=](size_t i) { return i == num_columns ? xmax : xmin + (xmax - xmin) * i / num_columns; };
+
+    MultiChannelScratch local_scratch;
+    if (!scratch) { scratch = &local_scratch; }
+
+    std::vector<size_t>& edge_lo_idx = scratch->edge_lo_idx_;
+    std::vector<size_t>& edge_hi_bound = scratch->edge_hi_bound_;
+    std::vector<std::optional<double>>& edge_interp = scratch->edge_interp_;
+    edge_lo_idx.resize(num_columns + 1);
+    edge_hi_bound.resize(num_columns + 1);
+    edge_interp.resize(num_columns + 1);
+
+    const ValueAccess x_access{*this, 0};
+    for (size_t i = 0; i <= num_columns; ++i)
+    {
+        edge_lo_idx[i] = x_access.LowerBound(column_edge(i), i == 0 ? 0 : edge_lo_idx[i - 1]);
+        edge_hi_bound[i] = GetUpperBound(x_access, column_edge(i), edge_lo_idx[i]);
+    }
+
+    for (size_t r = 0; r < channels.size(); ++r)
+    {
+        PLOT_ASSERT(channels[r] < channels_.size());
+
+        const ValueAccess values{*this, channels[r]};
+        for (size_t i = 0; i <= num_columns; ++i)
+        {
+            edge_interp[i] = GetInterpolatedValue(values, column_edge(i), edge_lo_idx[i]);
+        }
+
+        for (size_t i = 0; i < num_columns; ++i)
+        {
+            SetResult(output, r * num_columns + i, GetMinMaxOverBounds(
+                values, edge_lo_idx[i], edge_hi_bound[i + 1], edge_interp[i], edge_interp[i + 1]
+            ));
+        }
+    }
+}
+
+template class BasicMultiChannelCurve2D<double>;
+template class BasicMultiChannelCurve2D<float>;
+template class BasicMultiChannelCurve2D<int32_t>;
+template class BasicMultiChannelCurve2D<int16_t>;
+
+} // namespace plot
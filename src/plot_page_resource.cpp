@@ -0,0 +1,172 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_assert.hpp"
+#include "plot_page_resource.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace plot {
+
+// Values of the kernel's memory policy modes (see `mbind(2)`); not taken from <numaif.h>,
+// which is provided by libnuma.
+constexpr int MPOL_BIND_MODE = 2;
+constexpr int MPOL_INTERLEAVE_MODE = 3;
+
+static size_t GetPageSize()
+{
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return page_size;
+}
+
+static size_t RoundUp(size_t value, size_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+/// Maps `size` bytes (a multiple of `HUGE_PAGE_SIZE`) aligned to `HUGE_PAGE_SIZE`; returns null if failed.
+static void* MapAligned(size_t size)
+{
+    // map more and unmap the unaligned head and tail
+    const size_t mapped_size = size + HUGE_PAGE_SIZE;
+    void* mapping = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) { return nullptr; }
+
+    const uintptr_t start = reinterpret_cast<uintptr_t>(mapping);
+    const uintptr_t aligned = RoundUp(start, HUGE_PAGE_SIZE);
+    if (aligned > start) { munmap(mapping, aligned - start); }
+    if (start + mapped_size > aligned + size) { munmap(reinterpret_cast<void*>(aligned + size), start + mapped_size - aligned - size); }
+
+    return reinterpret_cast<void*>(aligned);
+}
+
+constexpr size_t BITS_PER_MASK_WORD = 8 * sizeof(unsigned long);
+
+/// Applies the NUMA policy to the (not yet touched) pages of [ptr, ptr + size); ignores failures.
+///
+/// @param node_mask Nodes of the policy; nothing is done if empty.
+///
+static void SetNumaPolicy(void* ptr, size_t size, NumaPolicy policy, const std::vector<unsigned long>& node_mask)
+{
+    if (node_mask.empty()) { return; }
+
+    const int mode = (policy == NumaPolicy::Interleave) ? MPOL_INTERLEAVE_MODE : MPOL_BIND_MODE;
+    // the kernel uses one bit less than the given max. node
+    syscall(SYS_mbind, ptr, size, mode, node_mask.data(), node_mask.size() * BITS_PER_MASK_WORD + 1, 0u);
+}
+
+PageResource::PageResource(const PageResourceOptions& options)
+: options_(options)
+{
+    if (options_.numa_policy == NumaPolicy::Default) { return; }
+
+    // read once, not on each allocation
+    const std::vector<unsigned> nodes = options_.numa_nodes.empty() ? GetNumaNodes() : options_.numa_nodes;
+    for (unsigned node: nodes)
+    {
+        if (node / BITS_PER_MASK_WORD >= node_mask_.size()) { node_mask_.resize(node / BITS_PER_MASK_WORD + 1, 0); }
+        node_mask_[node / BITS_PER_MASK_WORD] |= 1ul << (node % BITS_PER_MASK_WORD);
+    }
+}
+
+size_t PageResource::GetMappedSize(size_t num_bytes) const
+{
+    return RoundUp(std::max(num_bytes, size_t{1}), options_.huge_pages == HugePages::None ? GetPageSize() : HUGE_PAGE_SIZE);
+}
+
+void* PageResource::do_allocate(size_t num_bytes, size_t alignment)
+{
+    const size_t size = GetMappedSize(num_bytes);
+    void* ptr = nullptr;
+
+    switch (options_.huge_pages)
+    {
+    case HugePages::None:
+        PLOT_ASSERT(alignment <= GetPageSize());
+        ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) { ptr = nullptr; }
+        break;
+
+    case HugePages::Explicit:
+        PLOT_ASSERT(alignment <= HUGE_PAGE_SIZE);
+        ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr != MAP_FAILED) { break; }
+        ptr = nullptr;
+        [[fallthrough]];
+
+    case HugePages::Transparent:
+        PLOT_ASSERT(alignment <= HUGE_PAGE_SIZE);
+        ptr = MapAligned(size);
+        if (ptr) { madvise(ptr, size, MADV_HUGEPAGE); }
+        break;
+    }
+
+    if (!ptr) { throw std::bad_alloc(); }
+
+    SetNumaPolicy(ptr, size, options_.numa_policy, node_mask_);
+
+    return ptr;
+}
+
+void PageResource::do_deallocate(void* ptr, size_t num_bytes, size_t)
+{
+    munmap(ptr, GetMappedSize(num_bytes));
+}
+
+std::vector<unsigned> GetNumaNodes()
+{
+    // a list of ranges, e.g. "0-1,4"
+    std::ifstream file("/sys/devices/system/node/online");
+    std::string list;
+    std::vector<unsigned> nodes;
+
+    if (file >> list)
+    {
+        size_t pos = 0;
+        while (pos < list.size())
+        {
+            size_t end = list.find(',', pos);
+            if (end == std::string::npos) { end = list.size(); }
+
+            const std::string range = list.substr(pos, end - pos);
+            const size_t dash = range.find('-');
+            try
+            {
+                const unsigned first = static_cast<unsigned>(std::stoul(range.substr(0, dash)));
+                const unsigned last = (dash == std::string::npos) ? first : static_cast<unsigned>(std::stoul(range.substr(dash + 1)));
+                for (unsigned node = first; node <= last; ++node) { nodes.push_back(node); }
+            }
+            catch (const std::exception&)
+            {
+                return {0};
+            }
+
+            pos = end + 1;
+        }
+    }
+
+    return nodes.empty() ? std::vector<unsigned>{0} : nodes;
+}
+
+unsigned GetCurrentNumaNode()
+{
+    unsigned cpu = 0;
+    unsigned node = 0;
+
+    return syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 ? node : 0;
+}
+
+} // namespace plot
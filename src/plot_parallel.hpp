@@ -0,0 +1,75 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_PARALLEL_H
+#define PLOT_PARALLEL_H
+
+#include "plot_stats_internal.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace plot {
+
+/// Min. number of values processed by a separate thread when building a curve.
+constexpr size_t MIN_VALUES_PER_THREAD = size_t{1} << 15;
+
+/// Returns `num_threads`, or the number of hardware threads if `num_threads` is 0.
+inline unsigned GetNumThreads(unsigned num_threads)
+{
+    return num_threads > 0 ? num_threads : std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/// Calls `func(begin, end)` for consecutive, disjoint subranges covering [0, num_items).
+///
+/// @param num_threads Max. number of threads to use (including the calling one); 0 means all hardware threads.
+/// @param min_items_per_thread Min. subrange length; avoids starting threads for little work.
+///
+/// With `PLOT_ENABLE_STATS`, the counters of the started threads are added to the calling thread's
+/// `GetThreadStats()` after they are joined, so that the work appears where the caller looks for it.
+///
+template<typename Func>
+void ParallelFor(size_t num_items, unsigned num_threads, size_t min_items_per_thread, Func func)
+{
+    const size_t num_chunks = std::max(
+        std::min(size_t{GetNumThreads(num_threads)}, num_items / std::max(min_items_per_thread, size_t{1})),
+        size_t{1}
+    );
+
+    if (num_chunks == 1)
+    {
+        func(size_t{0}, num_items);
+        return;
+    }
+
+#if PLOT_ENABLE_STATS
+    std::vector<Stats> thread_stats(num_chunks - 1);
+#endif
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < num_chunks; ++i)
+    {
+        threads.emplace_back([&, i, func]() mutable {
+            func(i * num_items / num_chunks, (i + 1) * num_items / num_chunks);
+            PLOT_STATS(thread_stats[i - 1] = GetThreadStats());
+        });
+    }
+    func(size_t{0}, num_items / num_chunks);
+
+    for (auto& thread: threads) { thread.join(); }
+
+    PLOT_STATS(for (const Stats& stats: thread_stats) { AddStats(GetThreadStats(), stats); });
+}
+
+} // namespace plot
+
+#endif // PLOT_PARALLEL_H
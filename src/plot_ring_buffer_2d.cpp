@@ -0,0 +1,113 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_assert.hpp"
+#include "plot_domain_query.hpp"
+#include "plot_ring_buffer_2d.hpp"
+
+#include <cstdint>
+
+namespace plot {
+
+template<typename T>
+BasicRingBufferCurve2D<T>::BasicRingBufferCurve2D(size_t capacity, const BuildOptions& options)
+: x_values_(capacity),
+  y_values_(std::make_shared<std::vector<std::optional<T>>>(capacity), options)
+{
+    PLOT_ASSERT(capacity > 0);
+}
+
+template<typename T>
+void BasicRingBufferCurve2D<T>::Append(double x, const std::optional<T>& y)
+{
+    PLOT_ASSERT(num_values_ == 0 || x > GetX(num_values_ - 1));
+
+    size_t slot;
+    if (num_values_ < GetCapacity())
+    {
+        slot = GetSlot(num_values_);
+        ++num_values_;
+    }
+    else
+    {
+        slot = first_slot_;
+        first_slot_ = GetSlot(1);
+    }
+
+    x_values_[slot] = x;
+    y_values_.SetValue(slot, y);
+}
+
+template<typename T>
+struct BasicRingBufferCurve2D<T>::ValueAccess
+{
+    const BasicRingBufferCurve2D& curve;
+
+    size_t GetNumValues() const { return curve.num_values_; }
+
+    double GetX(size_t idx) const { return curve.GetX(idx); }
+
+    std::optional<double> GetY(size_t idx) const
+    {
+        const std::optional<T>& y = curve.GetY(idx);
+        return y.has_value() ? std::optional<double>(*y) : std::nullopt;
+    }
+
+    size_t LowerBound(double x, size_t start_idx) const { return SearchLowerBound(*this, start_idx, x); }
+
+    MinMax GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx) const
+    {
+        const size_t lo_slot = curve.GetSlot(lo_idx);
+        const size_t hi_slot = curve.GetSlot(hi_idx);
+
+        if (lo_slot <= hi_slot)
+        {
+            return ToMinMax(curve.y_values_.GetMinMaxOverIndexInterval(lo_slot, hi_slot));
+        }
+        else
+        {
+            // the interval wraps around the end of the buffer
+            BasicMinMax<T> result = curve.y_values_.GetMinMaxOverIndexInterval(lo_slot, curve.GetCapacity() - 1);
+            result.Add(curve.y_values_.GetMinMaxOverIndexInterval(0, hi_slot));
+            return ToMinMax(result);
+        }
+    }
+};
+
+template<typename T>
+std::optional<std::tuple<double, double>> BasicRingBufferCurve2D<T>::GetMinMaxOverDomainInterval(double xmin, double xmax) const
+{
+    return plot::GetMinMaxOverDomainInterval(ValueAccess{*this}, xmin, xmax);
+}
+
+template<typename T>
+void BasicRingBufferCurve2D<T>::GetMinMaxOverDomainColumns(
+    double xmin,
+    double xmax,
+    size_t num_columns,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(ValueAccess{*this}, xmin, xmax, num_columns, output);
+}
+
+template<typename T>
+void BasicRingBufferCurve2D<T>::GetMinMaxOverDomainColumns(
+    const std::vector<double>& column_edges,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(ValueAccess{*this}, column_edges, output);
+}
+
+template class BasicRingBufferCurve2D<double>;
+template class BasicRingBufferCurve2D<float>;
+template class BasicRingBufferCurve2D<int32_t>;
+template class BasicRingBufferCurve2D<int16_t>;
+
+} // namespace plot
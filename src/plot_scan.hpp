@@ -0,0 +1,125 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_SCAN_H
+#define PLOT_SCAN_H
+
+#include "plot_min_max_tree.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+namespace plot {
+
+/// Returns the min and max of non-empty values among `values[0]`...`values[count-1]`.
+///
+/// Empty values are masked with the empty set's bounds (see `BasicMinMax::Empty()`) instead of branching;
+/// four independent accumulators let the compiler use packed min/max instructions.
+///
+template<typename T>
+BasicMinMax<T> ScanMinMax(const std::optional<T>* values, size_t count)
+{
+    const BasicMinMax<T> empty = BasicMinMax<T>::Empty();
+
+    T min[4] = { empty.min, empty.min, empty.min, empty.min };
+    T max[4] = { empty.max, empty.max, empty.max, empty.max };
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        for (size_t j = 0; j < 4; ++j)
+        {
+            min[j] = std::min(min[j], values[i + j].value_or(empty.min));
+            max[j] = std::max(max[j], values[i + j].value_or(empty.max));
+        }
+    }
+    for (; i < count; ++i)
+    {
+        min[0] = std::min(min[0], values[i].value_or(empty.min));
+        max[0] = std::max(max[0], values[i].value_or(empty.max));
+    }
+
+    return {
+        std::min(std::min(min[0], min[1]), std::min(min[2], min[3])),
+        std::max(std::max(max[0], max[1]), std::max(max[2], max[3]))
+    };
+}
+
+/// Returns the min and max of `values[0]`...`values[count-1]` (which are all present).
+template<typename T>
+BasicMinMax<T> ScanMinMax(const T* values, size_t count)
+{
+    BasicMinMax<T> result = BasicMinMax<T>::Empty();
+    for (size_t i = 0; i < count; ++i)
+    {
+        result.min = std::min(result.min, values[i]);
+        result.max = std::max(result.max, values[i]);
+    }
+
+    return result;
+}
+
+/// Returns the min and max of valid values among `values[begin_idx]`...`values[end_idx-1]`.
+///
+/// @param validity Bit `i % 8` of byte `i / 8` is set if `values[i]` is valid.
+///
+inline MinMax ScanMinMax(const double* values, const uint8_t* validity, size_t begin_idx, size_t end_idx)
+{
+    constexpr double INF = std::numeric_limits<double>::infinity();
+
+    MinMax result = MinMax::Empty();
+    for (size_t i = begin_idx; i < end_idx; ++i)
+    {
+        const bool is_valid = (validity[i / 8] >> (i % 8)) & 1;
+        result.min = std::min(result.min, is_valid ? values[i] : INF);
+        result.max = std::max(result.max, is_valid ? values[i] : -INF);
+    }
+
+    return result;
+}
+
+/// Returns the min and max of non-NaN values among `values[begin_idx]`...`values[end_idx-1]`.
+///
+/// NaNs are skipped without branching: `std::min(acc, NaN)` and `std::max(acc, NaN)` return `acc`.
+///
+inline MinMax ScanMinMax(const double* values, size_t begin_idx, size_t end_idx)
+{
+    constexpr double INF = std::numeric_limits<double>::infinity();
+
+    double min[4] = { INF, INF, INF, INF };
+    double max[4] = { -INF, -INF, -INF, -INF };
+
+    size_t i = begin_idx;
+    for (; i + 4 <= end_idx; i += 4)
+    {
+        for (size_t j = 0; j < 4; ++j)
+        {
+            min[j] = std::min(min[j], values[i + j]);
+            max[j] = std::max(max[j], values[i + j]);
+        }
+    }
+    for (; i < end_idx; ++i)
+    {
+        min[0] = std::min(min[0], values[i]);
+        max[0] = std::max(max[0], values[i]);
+    }
+
+    return {
+        std::min(std::min(min[0], min[1]), std::min(min[2], min[3])),
+        std::max(std::max(max[0], max[1]), std::max(max[2], max[3]))
+    };
+}
+
+} // namespace plot
+
+#endif // PLOT_SCAN_H
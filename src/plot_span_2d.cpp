@@ -0,0 +1,140 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_assert.hpp"
+#include "plot_build.hpp"
+#include "plot_domain_query.hpp"
+#include "plot_scan.hpp"
+#include "plot_span_2d.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace plot {
+
+SpanExplicitSingleValueCurve2D::SpanExplicitSingleValueCurve2D(
+    const double* x_values,
+    const double* y_values,
+    size_t num_values,
+    const uint8_t* validity,
+    const BuildOptions& options
+): x_values_(x_values), y_values_(y_values), validity_(validity), num_values_(num_values), leaf_size_(options.leaf_size),
+   tree_(0, options.memory_resource)
+{
+    PLOT_ASSERT(num_values_ == 0 || x_values_ && y_values_);
+    PLOT_ASSERT(leaf_size_ > 0 && (leaf_size_ & (leaf_size_ - 1)) == 0);
+    PLOT_ASSERT(IsStrictlyIncreasing(x_values_, num_values_, options.num_threads));
+
+    tree_.ResizeUninitialized(MinMaxTree::GetNumLeavesFor(num_values, options.leaf_size));
+    const bool is_complete = FillTree(
+        tree_,
+        num_values_,
+        leaf_size_,
+        options.num_threads,
+        [this](size_t begin_idx, size_t end_idx) { return ScanYValues(begin_idx, end_idx); },
+        options.cancel
+    );
+
+    if (!is_complete) { throw BuildCancelled(); }
+
+    if (options.build_x_index) { x_index_ = XIndex(x_values_, num_values_); }
+}
+
+MinMax SpanExplicitSingleValueCurve2D::ScanYValues(size_t begin_idx, size_t end_idx) const
+{
+    if (validity_)
+    {
+        return ScanMinMax(y_values_, validity_, begin_idx, end_idx);
+    }
+    else
+    {
+        return ScanMinMax(y_values_, begin_idx, end_idx);
+    }
+}
+
+struct SpanExplicitSingleValueCurve2D::ValueAccess
+{
+    const SpanExplicitSingleValueCurve2D& curve;
+
+    size_t GetNumValues() const { return curve.num_values_; }
+
+    double GetX(size_t idx) const { return curve.x_values_[idx]; }
+
+    std::optional<double> GetY(size_t idx) const
+    {
+        const bool is_valid = curve.validity_
+            ? (curve.validity_[idx / 8] >> (idx % 8)) & 1
+            : !std::isnan(curve.y_values_[idx]);
+
+        if (is_valid)
+        {
+            return curve.y_values_[idx];
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+    size_t LowerBound(double x, size_t start_idx) const
+    {
+        if (start_idx == 0 && curve.x_index_.GetNumValues() > 0)
+        {
+            return GallopingLowerBound(*this, curve.x_index_.GetSearchStart(x), x);
+        }
+        else
+        {
+            return SearchLowerBound(*this, start_idx, x);
+        }
+    }
+
+    MinMax GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx) const
+    {
+        return plot::GetMinMaxOverIndexInterval(
+            curve.tree_.GetView(),
+            curve.leaf_size_,
+            lo_idx,
+            hi_idx,
+            [this](size_t begin_idx, size_t end_idx) { return curve.ScanYValues(begin_idx, end_idx); }
+        );
+    }
+};
+
+std::optional<std::tuple<double, double>> SpanExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval(double xmin, double xmax) const
+{
+    return plot::GetMinMaxOverDomainInterval(ValueAccess{*this}, xmin, xmax);
+}
+
+std::optional<std::tuple<double, double>> SpanExplicitSingleValueCurve2D::GetMinMaxOverDomainInterval(
+    double xmin,
+    double xmax,
+    SearchHint& hint
+) const
+{
+    return plot::GetMinMaxOverDomainInterval(ValueAccess{*this}, xmin, xmax, hint);
+}
+
+void SpanExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns(
+    double xmin,
+    double xmax,
+    size_t num_columns,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(ValueAccess{*this}, xmin, xmax, num_columns, output);
+}
+
+void SpanExplicitSingleValueCurve2D::GetMinMaxOverDomainColumns(
+    const std::vector<double>& column_edges,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(ValueAccess{*this}, column_edges, output);
+}
+
+} // namespace plot
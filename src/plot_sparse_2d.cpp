@@ -0,0 +1,230 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_assert.hpp"
+#include "plot_build.hpp"
+#include "plot_domain_query.hpp"
+#include "plot_scan.hpp"
+#include "plot_sparse_2d.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace plot {
+
+template<typename T>
+BasicSparseExplicitSingleValueCurve2D<T>::BasicSparseExplicitSingleValueCurve2D(
+    const std::vector<double>& x_values,
+    const std::vector<std::optional<T>>& y_values,
+    const BuildOptions& options
+)
+: tree_(0, options.memory_resource),
+  leaf_size_(options.leaf_size),
+  num_threads_(options.num_threads),
+  id_(GetNewCurveId()),
+  num_values_(x_values.size()),
+  last_x_(x_values.empty() ? 0.0 : x_values.back())
+{
+    PLOT_ASSERT(x_values.size() == y_values.size());
+    PLOT_ASSERT(leaf_size_ > 0 && (leaf_size_ & (leaf_size_ - 1)) == 0);
+    PLOT_ASSERT(IsStrictlyIncreasing(x_values.data(), x_values.size(), num_threads_));
+
+    for (size_t i = 0; i < x_values.size(); ++i)
+    {
+        if (!y_values[i].has_value()) { continue; }
+
+        if (i == 0 || !y_values[i - 1].has_value())
+        {
+            runs_.push_back({x_values_.size(), x_values_.size() + 1});
+        }
+        else
+        {
+            runs_.back().end_idx = x_values_.size() + 1;
+        }
+
+        x_values_.push_back(x_values[i]);
+        y_values_.push_back(*y_values[i]);
+    }
+
+    is_in_gap_ = !y_values.empty() && !y_values.back().has_value();
+
+    BuildTree(options.cancel);
+}
+
+template<typename T>
+BasicMinMax<T> BasicSparseExplicitSingleValueCurve2D<T>::ScanValues(size_t begin_idx, size_t end_idx) const
+{
+    return ScanMinMax(y_values_.data() + begin_idx, end_idx - begin_idx);
+}
+
+template<typename T>
+void BasicSparseExplicitSingleValueCurve2D<T>::BuildTree(const std::atomic<bool>* cancel)
+{
+    // the tree has at least one leaf, so that a 1-element sequence can be queried like any other
+    tree_.ResizeUninitialized(std::max(tree_.GetNumLeaves(), BasicMinMaxTree<T>::GetNumLeavesFor(x_values_.size(), leaf_size_)));
+
+    const bool is_complete = plot::FillTree(
+        tree_,
+        x_values_.size(),
+        leaf_size_,
+        num_threads_,
+        [this](size_t begin_idx, size_t end_idx) { return ScanValues(begin_idx, end_idx); },
+        cancel
+    );
+
+    if (!is_complete) { throw BuildCancelled(); }
+}
+
+template<typename T>
+void BasicSparseExplicitSingleValueCurve2D<T>::Append(double x, const std::optional<T>& y)
+{
+    PLOT_ASSERT(num_values_ == 0 || x > last_x_);
+
+    if (y.has_value())
+    {
+        if (is_in_gap_ || runs_.empty())
+        {
+            runs_.push_back({x_values_.size(), x_values_.size() + 1});
+        }
+        else
+        {
+            runs_.back().end_idx = x_values_.size() + 1;
+        }
+
+        x_values_.push_back(x);
+        y_values_.push_back(*y);
+
+        if (x_values_.size() > leaf_size_ * tree_.GetNumLeaves())
+        {
+            BuildTree(nullptr);
+        }
+        else
+        {
+            const size_t leaf = (x_values_.size() - 1) / leaf_size_;
+            tree_.SetLeaf(leaf, GetLeafMinMax(leaf, x_values_.size(), leaf_size_, [this](size_t begin_idx, size_t end_idx) {
+                return ScanValues(begin_idx, end_idx);
+            }));
+            tree_.UpdateAncestors(leaf, leaf);
+        }
+    }
+
+    is_in_gap_ = !y.has_value();
+    ++num_values_;
+    last_x_ = x;
+}
+
+template<typename T>
+struct BasicSparseExplicitSingleValueCurve2D<T>::ValueAccess
+{
+    const BasicSparseExplicitSingleValueCurve2D& curve;
+
+    size_t GetNumValues() const { return curve.x_values_.size(); }
+
+    double GetX(size_t idx) const { return curve.x_values_[idx]; }
+
+    std::optional<double> GetY(size_t idx) const { return curve.y_values_[idx]; }
+
+    size_t LowerBound(double x, size_t start_idx) const
+    {
+        if (start_idx > 0) { return SearchLowerBound(*this, start_idx, x); }
+
+        // the first run whose last X value is not less than `x` contains the result (if any run does)
+        const auto& runs = curve.runs_;
+        const auto run = std::lower_bound(runs.begin(), runs.end(), x, [this](const Run& r, double value) {
+            return GetX(r.end_idx - 1) < value;
+        });
+        if (run == runs.end()) { return GetNumValues(); }
+
+        return BinaryLowerBound(*this, run->first_idx, run->end_idx, x);
+    }
+
+    bool IsGapBefore(size_t idx) const
+    {
+        const auto& runs = curve.runs_;
+        const auto run = std::lower_bound(runs.begin(), runs.end(), idx, [](const Run& r, size_t value) {
+            return r.first_idx < value;
+        });
+
+        return idx > 0 && run != runs.end() && run->first_idx == idx;
+    }
+
+    MinMax GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx) const
+    {
+        return ToMinMax(plot::GetMinMaxOverIndexInterval(
+            curve.tree_.GetView(),
+            curve.leaf_size_,
+            lo_idx,
+            hi_idx,
+            [this](size_t begin_idx, size_t end_idx) { return curve.ScanValues(begin_idx, end_idx); }
+        ));
+    }
+
+    MinMax GetBlockMinMax(size_t block_idx, size_t block_size) const
+    {
+        return ToMinMax(GetTreeBlockMinMax(
+            curve.tree_.GetView(),
+            curve.x_values_.size(),
+            curve.leaf_size_,
+            block_idx,
+            block_size,
+            [this](size_t begin_idx, size_t end_idx) { return curve.ScanValues(begin_idx, end_idx); }
+        ));
+    }
+};
+
+template<typename T>
+std::optional<std::tuple<double, double>> BasicSparseExplicitSingleValueCurve2D<T>::GetMinMaxOverDomainInterval(
+    double xmin,
+    double xmax
+) const
+{
+    return plot::GetMinMaxOverDomainInterval(ValueAccess{*this}, xmin, xmax);
+}
+
+template<typename T>
+std::optional<std::tuple<double, double>> BasicSparseExplicitSingleValueCurve2D<T>::GetMinMaxOverDomainInterval(
+    double xmin,
+    double xmax,
+    SearchHint& hint
+) const
+{
+    return plot::GetMinMaxOverDomainInterval(ValueAccess{*this}, xmin, xmax, hint);
+}
+
+template<typename T>
+void BasicSparseExplicitSingleValueCurve2D<T>::GetMinMaxOverDomainColumns(
+    double xmin,
+    double xmax,
+    size_t num_columns,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(ValueAccess{*this}, xmin, xmax, num_columns, output);
+}
+
+template<typename T>
+void BasicSparseExplicitSingleValueCurve2D<T>::GetMinMaxOverDomainColumns(
+    const std::vector<double>& column_edges,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(ValueAccess{*this}, column_edges, output);
+}
+
+template<typename T>
+void BasicSparseExplicitSingleValueCurve2D<T>::GetEnvelope(double xmin, double xmax, size_t width, std::vector<EnvelopePoint>& output) const
+{
+    plot::GetEnvelope(ValueAccess{*this}, xmin, xmax, width, output);
+}
+
+template class BasicSparseExplicitSingleValueCurve2D<double>;
+template class BasicSparseExplicitSingleValueCurve2D<float>;
+template class BasicSparseExplicitSingleValueCurve2D<int32_t>;
+template class BasicSparseExplicitSingleValueCurve2D<int16_t>;
+
+} // namespace plot
@@ -0,0 +1,31 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_stats_internal.hpp"
+
+namespace plot {
+
+/// Per-thread, so that concurrent queries do not contend for the counters.
+static thread_local Stats thread_stats;
+
+Stats& GetThreadStats()
+{
+    return thread_stats;
+}
+
+const Stats& GetStats()
+{
+    return thread_stats;
+}
+
+void ResetStats()
+{
+    thread_stats = Stats{};
+}
+
+} // namespace plot
@@ -0,0 +1,44 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#pragma once
+
+#ifndef PLOT_STATS_INTERNAL_H
+#define PLOT_STATS_INTERNAL_H
+
+#include "plot_stats.hpp"
+
+namespace plot {
+
+/// Returns the counters of the calling thread for updating.
+Stats& GetThreadStats();
+
+/// Adds the counters of `other` (e.g. of a worker thread) to `stats`.
+inline void AddStats(Stats& stats, const Stats& other)
+{
+    stats.num_queries += other.num_queries;
+    stats.num_search_steps += other.num_search_steps;
+    stats.num_interpolations += other.num_interpolations;
+    stats.num_nodes_visited += other.num_nodes_visited;
+    stats.num_leaf_scans += other.num_leaf_scans;
+    stats.num_values_scanned += other.num_values_scanned;
+    stats.num_builds += other.num_builds;
+    stats.build_time_ns += other.build_time_ns;
+    stats.build_bytes += other.build_bytes;
+}
+
+} // namespace plot
+
+/// Executes `statement` (which updates `GetThreadStats()`) only if built with `PLOT_ENABLE_STATS`.
+#if PLOT_ENABLE_STATS
+#define PLOT_STATS(statement) do { statement; } while (false)
+#else
+#define PLOT_STATS(statement) do { } while (false)
+#endif
+
+#endif // PLOT_STATS_INTERNAL_H
@@ -0,0 +1,126 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_assert.hpp"
+#include "plot_tiles.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace plot {
+
+constexpr uint32_t TILE_BYTE_ORDER_MARK = 0x01020304;
+
+constexpr size_t TILE_HEADER_SIZE =
+    sizeof(uint32_t) + 2 * sizeof(uint64_t) + 2 * sizeof(double) + sizeof(int32_t) + sizeof(int64_t) + sizeof(uint32_t);
+
+template<typename V>
+static void Write(std::vector<uint8_t>& output, const V& value)
+{
+    const size_t offset = output.size();
+    output.resize(offset + sizeof(value));
+    std::memcpy(output.data() + offset, &value, sizeof(value));
+}
+
+template<typename V>
+static V Read(const uint8_t* data, size_t& offset)
+{
+    V value;
+    std::memcpy(&value, data + offset, sizeof(value));
+    offset += sizeof(value);
+
+    return value;
+}
+
+std::vector<uint8_t> SerializeTile(const Tile& tile)
+{
+    PLOT_ASSERT(tile.columns.size() == tile.key.grid.num_columns);
+    // the header stores the number of columns in 32 bits
+    PLOT_ASSERT(tile.columns.size() <= UINT32_MAX);
+
+    size_t num_valid = 0;
+    for (const auto& column: tile.columns)
+    {
+        if (column.has_value()) { ++num_valid; }
+    }
+
+    const size_t validity_size = (tile.columns.size() + 7) / 8;
+
+    std::vector<uint8_t> output;
+    output.reserve(TILE_HEADER_SIZE + validity_size + num_valid * 2 * sizeof(double));
+
+    Write(output, TILE_BYTE_ORDER_MARK);
+    Write(output, tile.key.curve_id);
+    Write(output, tile.key.revision);
+    Write(output, tile.key.grid.origin);
+    Write(output, tile.key.grid.base_tile_width);
+    Write(output, tile.key.zoom);
+    Write(output, tile.key.tile_idx);
+    Write(output, static_cast<uint32_t>(tile.columns.size()));
+
+    const size_t validity_offset = output.size();
+    output.resize(validity_offset + validity_size, 0);
+    for (size_t i = 0; i < tile.columns.size(); ++i)
+    {
+        if (tile.columns[i].has_value()) { output[validity_offset + i / 8] |= 1 << (i % 8); }
+    }
+
+    for (const auto& column: tile.columns)
+    {
+        if (column.has_value())
+        {
+            Write(output, std::get<0>(*column));
+            Write(output, std::get<1>(*column));
+        }
+    }
+
+    return output;
+}
+
+Tile DeserializeTile(const uint8_t* data, size_t size)
+{
+    if (size < TILE_HEADER_SIZE) { throw std::runtime_error("invalid tile: too short"); }
+
+    size_t offset = 0;
+    if (Read<uint32_t>(data, offset) != TILE_BYTE_ORDER_MARK) { throw std::runtime_error("invalid tile: wrong byte order mark"); }
+
+    Tile tile;
+    tile.key.curve_id = Read<uint64_t>(data, offset);
+    tile.key.revision = Read<uint64_t>(data, offset);
+    tile.key.grid.origin = Read<double>(data, offset);
+    tile.key.grid.base_tile_width = Read<double>(data, offset);
+    tile.key.zoom = Read<int32_t>(data, offset);
+    tile.key.tile_idx = Read<int64_t>(data, offset);
+    const size_t num_columns = Read<uint32_t>(data, offset);
+    tile.key.grid.num_columns = num_columns;
+
+    const uint8_t* validity = data + offset;
+    const size_t validity_size = (num_columns + 7) / 8;
+    if (size - offset < validity_size) { throw std::runtime_error("invalid tile: too short"); }
+    offset += validity_size;
+
+    tile.columns.resize(num_columns);
+    for (size_t i = 0; i < num_columns; ++i)
+    {
+        if (validity[i / 8] & (1 << (i % 8)))
+        {
+            if (size - offset < 2 * sizeof(double)) { throw std::runtime_error("invalid tile: too short"); }
+
+            const double min = Read<double>(data, offset);
+            const double max = Read<double>(data, offset);
+            tile.columns[i] = std::make_tuple(min, max);
+        }
+    }
+
+    if (offset != size) { throw std::runtime_error("invalid tile: unexpected trailing data"); }
+
+    return tile;
+}
+
+} // namespace plot
@@ -0,0 +1,130 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_assert.hpp"
+#include "plot_domain_query.hpp"
+#include "plot_uniform_2d.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+namespace plot {
+
+template<typename T>
+BasicUniformExplicitSingleValueCurve2D<T>::BasicUniformExplicitSingleValueCurve2D(
+    double x0,
+    double dx,
+    std::shared_ptr<std::vector<std::optional<T>>> y_values,
+    const BuildOptions& options
+): x0_(x0), dx_(dx), y_values_(y_values, options)
+{
+    PLOT_ASSERT(dx_ > 0 && std::isfinite(dx_) && std::isfinite(x0_));
+}
+
+template<typename T>
+void BasicUniformExplicitSingleValueCurve2D<T>::Append(const std::optional<T>& y)
+{
+    y_values_.Append(y);
+}
+
+template<typename T>
+void BasicUniformExplicitSingleValueCurve2D<T>::AppendBatch(const std::vector<std::optional<T>>& y_values)
+{
+    y_values_.AppendBatch(y_values);
+}
+
+template<typename T>
+struct BasicUniformExplicitSingleValueCurve2D<T>::ValueAccess
+{
+    const BasicUniformExplicitSingleValueCurve2D& curve;
+
+    size_t GetNumValues() const { return curve.y_values_.GetNumValues(); }
+
+    double GetX(size_t idx) const { return curve.GetX(idx); }
+
+    std::optional<double> GetY(size_t idx) const
+    {
+        const std::optional<T>& y = curve.y_values_.GetValues()[idx];
+        return y.has_value() ? std::optional<double>(*y) : std::nullopt;
+    }
+
+    size_t LowerBound(double x, size_t /*start_idx*/) const
+    {
+        const size_t num_values = GetNumValues();
+        const double pos = (x - curve.x0_) / curve.dx_;
+
+        size_t idx;
+        if (!(pos > 0))
+        {
+            idx = 0;
+        }
+        else if (pos >= static_cast<double>(num_values))
+        {
+            idx = num_values;
+        }
+        else
+        {
+            idx = static_cast<size_t>(std::ceil(pos));
+        }
+
+        // `pos` is subject to rounding; make the result consistent with `GetX()`
+        while (idx > 0 && !(GetX(idx - 1) < x)) { --idx; }
+        while (idx < num_values && GetX(idx) < x) { ++idx; }
+
+        return idx;
+    }
+
+    MinMax GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx) const
+    {
+        return ToMinMax(curve.y_values_.GetMinMaxOverIndexInterval(lo_idx, hi_idx));
+    }
+
+    MinMax GetBlockMinMax(size_t block_idx, size_t block_size) const
+    {
+        return ToMinMax(curve.y_values_.GetBlockMinMax(block_idx, block_size));
+    }
+};
+
+template<typename T>
+std::optional<std::tuple<double, double>> BasicUniformExplicitSingleValueCurve2D<T>::GetMinMaxOverDomainInterval(double xmin, double xmax) const
+{
+    return plot::GetMinMaxOverDomainInterval(ValueAccess{*this}, xmin, xmax);
+}
+
+template<typename T>
+void BasicUniformExplicitSingleValueCurve2D<T>::GetMinMaxOverDomainColumns(
+    double xmin,
+    double xmax,
+    size_t num_columns,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(ValueAccess{*this}, xmin, xmax, num_columns, output);
+}
+
+template<typename T>
+void BasicUniformExplicitSingleValueCurve2D<T>::GetMinMaxOverDomainColumns(
+    const std::vector<double>& column_edges,
+    std::vector<std::optional<std::tuple<double, double>>>& output
+) const
+{
+    plot::GetMinMaxOverDomainColumns(ValueAccess{*this}, column_edges, output);
+}
+
+template<typename T>
+void BasicUniformExplicitSingleValueCurve2D<T>::GetEnvelope(double xmin, double xmax, size_t width, std::vector<EnvelopePoint>& output) const
+{
+    plot::GetEnvelope(ValueAccess{*this}, xmin, xmax, width, output);
+}
+
+template class BasicUniformExplicitSingleValueCurve2D<double>;
+template class BasicUniformExplicitSingleValueCurve2D<float>;
+template class BasicUniformExplicitSingleValueCurve2D<int32_t>;
+template class BasicUniformExplicitSingleValueCurve2D<int16_t>;
+
+} // namespace plot
@@ -0,0 +1,230 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_assert.hpp"
+#include "plot_build.hpp"
+#include "plot_domain_query.hpp"
+#include "plot_scan.hpp"
+#include "plot_value_tree.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace plot {
+
+template<typename T, typename Aggregation>
+BasicValueTree<T, Aggregation>::BasicValueTree(std::shared_ptr<std::vector<std::optional<T>>> values, const BuildOptions& options)
+: values_(values), options_(options), id_(GetNewCurveId()), tree_(0, options.memory_resource)
+{
+    PLOT_ASSERT(options_.leaf_size > 0 && (options_.leaf_size & (options_.leaf_size - 1)) == 0);
+
+    if (options_.lazy)
+    {
+        build_once_ = std::make_unique<std::once_flag>();
+    }
+    else
+    {
+        Reserve(values_->size());
+    }
+
+    // later builds (after appending) are not cancellable; the flag need not outlive the constructor
+    options_.cancel = nullptr;
+}
+
+template<typename T, typename Aggregation>
+void BasicValueTree<T, Aggregation>::BuildTree() const
+{
+    tree_.ResizeUninitialized(BasicMinMaxTree<T, Aggregation>::GetNumLeavesFor(values_->size(), options_.leaf_size));
+    FillTree();
+}
+
+template<typename T, typename Aggregation>
+void BasicValueTree<T, Aggregation>::Reserve(size_t num_values)
+{
+    // the tree has at least one leaf, so that a 1-element sequence can be queried like any other
+    const size_t num_leaves = std::max(tree_.GetNumLeaves(), BasicMinMaxTree<T, Aggregation>::GetNumLeavesFor(num_values, options_.leaf_size));
+
+    if (num_leaves == tree_.GetNumLeaves()) { return; }
+
+    tree_.ResizeUninitialized(num_leaves);
+    FillTree();
+}
+
+template<typename T, typename Aggregation>
+void BasicValueTree<T, Aggregation>::Rebuild(std::shared_ptr<std::vector<std::optional<T>>> values)
+{
+    values_ = values;
+    ++version_;
+
+    if (build_once_)
+    {
+        build_once_ = std::make_unique<std::once_flag>();
+    }
+    else
+    {
+        BuildTree();
+    }
+}
+
+template<typename T, typename Aggregation>
+void BasicValueTree<T, Aggregation>::Append(const std::optional<T>& value)
+{
+    EnsureBuilt();
+
+    values_->push_back(value);
+    ++version_;
+
+    if (values_->size() > options_.leaf_size * tree_.GetNumLeaves())
+    {
+        Reserve(values_->size());
+    }
+    else
+    {
+        UpdateLeaves(values_->size() - 1, values_->size() - 1);
+    }
+}
+
+template<typename T, typename Aggregation>
+void BasicValueTree<T, Aggregation>::AppendBatch(const std::vector<std::optional<T>>& values)
+{
+    if (values.empty()) { return; }
+    EnsureBuilt();
+
+    const size_t first_new_idx = values_->size();
+
+    values_->insert(values_->end(), values.begin(), values.end());
+    ++version_;
+
+    if (values_->size() > options_.leaf_size * tree_.GetNumLeaves())
+    {
+        Reserve(values_->size());
+    }
+    else
+    {
+        UpdateLeaves(first_new_idx, values_->size() - 1);
+    }
+}
+
+template<typename T, typename Aggregation>
+void BasicValueTree<T, Aggregation>::SetValue(size_t idx, const std::optional<T>& value)
+{
+    PLOT_ASSERT(idx < values_->size());
+    EnsureBuilt();
+
+    (*values_)[idx] = value;
+    ++version_;
+    UpdateLeaves(idx, idx);
+}
+
+template<typename T, typename Aggregation>
+void BasicValueTree<T, Aggregation>::SetRange(size_t first_idx, const std::vector<std::optional<T>>& values)
+{
+    if (values.empty()) { return; }
+    PLOT_ASSERT(first_idx <= values_->size() && values.size() <= values_->size() - first_idx);
+    EnsureBuilt();
+
+    std::copy(values.begin(), values.end(), values_->begin() + first_idx);
+    ++version_;
+    UpdateLeaves(first_idx, first_idx + values.size() - 1);
+}
+
+template<typename T, typename Aggregation>
+typename BasicValueTree<T, Aggregation>::Node BasicValueTree<T, Aggregation>::ScanValues(size_t begin_idx, size_t end_idx) const
+{
+    const std::optional<T>* values = values_->data() + begin_idx;
+
+    if constexpr (Aggregation::HAS_EXTRA)
+    {
+        return Node{ScanMinMax(values, end_idx - begin_idx), Aggregation::ScanExtra(values, end_idx - begin_idx)};
+    }
+    else
+    {
+        return ScanMinMax(values, end_idx - begin_idx);
+    }
+}
+
+template<typename T, typename Aggregation>
+typename BasicValueTree<T, Aggregation>::Node BasicValueTree<T, Aggregation>::GetLeafValue(size_t leaf_idx) const
+{
+    return GetLeafMinMax(leaf_idx, values_->size(), options_.leaf_size, [this](size_t begin_idx, size_t end_idx) {
+        return ScanValues(begin_idx, end_idx);
+    });
+}
+
+template<typename T, typename Aggregation>
+void BasicValueTree<T, Aggregation>::FillTree() const
+{
+    // each leaf of `tree_` contains `options_.leaf_size` consecutive `values_`;
+    // the leaves past the end of `values_` are empty
+
+    const bool is_complete = plot::FillTree(
+        tree_,
+        values_->size(),
+        options_.leaf_size,
+        options_.num_threads,
+        [this](size_t begin_idx, size_t end_idx) { return ScanValues(begin_idx, end_idx); },
+        options_.cancel
+    );
+
+    if (!is_complete) { throw BuildCancelled(); }
+}
+
+template<typename T, typename Aggregation>
+void BasicValueTree<T, Aggregation>::UpdateLeaves(size_t lo_idx, size_t hi_idx)
+{
+    const size_t first_leaf = lo_idx / options_.leaf_size;
+    const size_t last_leaf = hi_idx / options_.leaf_size;
+
+    for (size_t i = first_leaf; i <= last_leaf; ++i)
+    {
+        tree_.SetLeaf(i, GetLeafValue(i));
+    }
+
+    tree_.UpdateAncestors(first_leaf, last_leaf);
+}
+
+template<typename T, typename Aggregation>
+typename BasicValueTree<T, Aggregation>::Node BasicValueTree<T, Aggregation>::GetMinMaxOverIndexInterval(size_t lo_idx, size_t hi_idx) const
+{
+    EnsureBuilt();
+
+    return plot::GetMinMaxOverIndexInterval(
+        tree_.GetView(),
+        options_.leaf_size,
+        lo_idx,
+        hi_idx,
+        [this](size_t begin_idx, size_t end_idx) { return ScanValues(begin_idx, end_idx); }
+    );
+}
+
+template<typename T, typename Aggregation>
+typename BasicValueTree<T, Aggregation>::Node BasicValueTree<T, Aggregation>::GetBlockMinMax(size_t block_idx, size_t block_size) const
+{
+    EnsureBuilt();
+
+    return GetTreeBlockMinMax(
+        tree_.GetView(),
+        values_->size(),
+        options_.leaf_size,
+        block_idx,
+        block_size,
+        [this](size_t begin_idx, size_t end_idx) { return ScanValues(begin_idx, end_idx); }
+    );
+}
+
+template class BasicValueTree<double, MinMaxAggregation>;
+template class BasicValueTree<float, MinMaxAggregation>;
+template class BasicValueTree<int32_t, MinMaxAggregation>;
+template class BasicValueTree<int16_t, MinMaxAggregation>;
+
+template class BasicValueTree<double, FullAggregation>;
+template class BasicValueTree<float, FullAggregation>;
+template class BasicValueTree<int32_t, FullAggregation>;
+template class BasicValueTree<int16_t, FullAggregation>;
+
+} // namespace plot
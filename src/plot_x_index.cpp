@@ -0,0 +1,81 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#include "plot_stats_internal.hpp"
+#include "plot_x_index.hpp"
+
+namespace plot {
+
+XIndex::XIndex(const double* x_values, size_t num_values)
+: num_values_(num_values)
+{
+    const size_t num_samples = (num_values + SAMPLE_STRIDE - 1) / SAMPLE_STRIDE;
+    samples_.resize(num_samples + 1);
+
+    Build(x_values, 1, 0);
+}
+
+size_t XIndex::Build(const double* x_values, size_t node, size_t first_sample)
+{
+    // an in-order traversal visits the samples in order of their X values
+    if (node >= samples_.size()) { return first_sample; }
+
+    const size_t sample = Build(x_values, 2 * node, first_sample);
+    samples_[node] = x_values[sample * SAMPLE_STRIDE];
+
+    return Build(x_values, 2 * node + 1, sample + 1);
+}
+
+/// Returns the depth (the index of the highest set bit) of the 1-based node `node`.
+static size_t GetDepth(size_t node)
+{
+    return 63 - __builtin_clzll(node);
+}
+
+size_t XIndex::GetSampleRank(size_t node) const
+{
+    const size_t num_samples = samples_.size() - 1;
+    const size_t num_levels = GetDepth(num_samples) + 1;
+    const size_t depth = GetDepth(node);
+
+    // position in the in-order traversal of the perfect tree of `num_levels` levels
+    const size_t position = ((2 * (node - (size_t{1} << depth)) + 1) << (num_levels - 1 - depth)) - 1;
+
+    // the bottom level is filled from the left; its nodes are at even positions, of which the missing ones
+    // (past the first `num_bottom`) precede `node`
+    const size_t num_bottom = num_samples - (size_t{1} << (num_levels - 1)) + 1;
+    const size_t num_even_before = (position + 1) / 2;
+
+    return position - (num_even_before > num_bottom ? num_even_before - num_bottom : 0);
+}
+
+size_t XIndex::GetSearchStart(double x) const
+{
+    if (samples_.size() <= 1) { return 0; }
+
+    // descends to a leaf, recording the path in the bits of `node` (1: went right, i.e. the sample is less than `x`)
+    size_t node = 1;
+    while (node < samples_.size())
+    {
+        PLOT_STATS(++GetThreadStats().num_search_steps);
+        node = 2 * node + (samples_[node] < x ? 1 : 0);
+    }
+
+    // the first sample not less than `x` is where the path last went left: strip the trailing right turns
+    // and the left turn itself; if there is none, all samples are less than `x`
+    while (node & 1) { node >>= 1; }
+    node >>= 1;
+
+    if (node == 0) { return (samples_.size() - 2) * SAMPLE_STRIDE; }
+
+    const size_t x_idx = GetSampleRank(node) * SAMPLE_STRIDE;
+
+    return x_idx >= SAMPLE_STRIDE ? x_idx - SAMPLE_STRIDE : 0;
+}
+
+} // namespace plot
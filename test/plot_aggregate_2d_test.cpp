@@ -0,0 +1,218 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_aggregate_2d.hpp"
+
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using plot::Aggregate;
+using plot::AggregateCurve2D;
+
+static std::shared_ptr<std::vector<double>> MakeXValues(size_t num_values)
+{
+    auto x_values = std::make_shared<std::vector<double>>();
+    for (size_t i = 0; i < num_values; ++i) { x_values->push_back(0.5 * i); }
+
+    return x_values;
+}
+
+template<typename T>
+static std::shared_ptr<std::vector<std::optional<T>>> MakeYValues(size_t num_values)
+{
+    auto y_values = std::make_shared<std::vector<std::optional<T>>>();
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        y_values->push_back((i % 7 == 3 || (i >= 200 && i < 240)) ? std::nullopt : std::optional<T>((i * 59) % 97));
+    }
+
+    return y_values;
+}
+
+static Aggregate GetEmptyAggregate()
+{
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    return {INF, -INF, 0.0, 0, 0.0, 0.0};
+}
+
+/// Adds the values of `following`, which come after those of `aggregate`.
+static void Add(Aggregate& aggregate, const Aggregate& following)
+{
+    if (following.IsEmpty()) { return; }
+    if (aggregate.IsEmpty()) { aggregate = following; return; }
+
+    aggregate.min = std::min(aggregate.min, following.min);
+    aggregate.max = std::max(aggregate.max, following.max);
+    aggregate.sum += following.sum;
+    aggregate.count += following.count;
+    aggregate.last = following.last;
+}
+
+/// Returns the aggregate of the values with X in [xmin, xmax) (or [xmin, xmax] if `include_xmax`).
+template<typename T>
+static Aggregate GetAggregateBruteForce(
+    const std::vector<double>& x_values,
+    const std::vector<std::optional<T>>& y_values,
+    double xmin,
+    double xmax,
+    bool include_xmax
+)
+{
+    Aggregate result = GetEmptyAggregate();
+    for (size_t i = 0; i < x_values.size(); ++i)
+    {
+        if (x_values[i] >= xmin && (x_values[i] < xmax || include_xmax && x_values[i] == xmax) && y_values[i].has_value())
+        {
+            const double value = static_cast<double>(*y_values[i]);
+            Add(result, {value, value, value, 1, value, value});
+        }
+    }
+
+    return result;
+}
+
+static void CheckEqual(const Aggregate& expected, const Aggregate& actual)
+{
+    BOOST_REQUIRE_EQUAL(expected.count, actual.count);
+    if (expected.count > 0)
+    {
+        BOOST_REQUIRE_EQUAL(expected.min, actual.min);
+        BOOST_REQUIRE_EQUAL(expected.max, actual.max);
+        BOOST_REQUIRE_EQUAL(expected.sum, actual.sum);
+        BOOST_REQUIRE_EQUAL(expected.first, actual.first);
+        BOOST_REQUIRE_EQUAL(expected.last, actual.last);
+    }
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(AggregateCurveTests)
+
+BOOST_AUTO_TEST_CASE(IntervalAggregatesMatchBruteForce)
+{
+    const auto x_values = MakeXValues(500);
+    const auto y_values = MakeYValues<int32_t>(500);
+
+    for (size_t leaf_size: {1, 4, 32})
+    {
+        plot::BuildOptions options;
+        options.leaf_size = leaf_size;
+        const plot::BasicAggregateCurve2D<int32_t> curve(x_values, y_values, options);
+
+        for (double xmin = -1.0; xmin < 251.0; xmin += 3.25)
+        {
+            for (double width: {0.0, 0.5, 7.0, 80.0, 300.0})
+            {
+                CheckEqual(
+                    GetAggregateBruteForce(*x_values, *y_values, xmin, xmin + width, true),
+                    curve.GetAggregateOverDomainInterval(xmin, xmin + width)
+                );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ColumnsCountEachValueOnce)
+{
+    const auto x_values = MakeXValues(1000);
+    const auto y_values = MakeYValues<double>(1000);
+    const AggregateCurve2D curve(x_values, y_values);
+
+    std::vector<Aggregate> columns;
+    curve.GetAggregateOverDomainColumns(0.0, 499.5, 37, columns);
+    BOOST_REQUIRE_EQUAL(37, columns.size());
+
+    Aggregate total = GetEmptyAggregate();
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        const double xmin = 499.5 * i / 37;
+        const double xmax = 499.5 * (i + 1) / 37;
+        CheckEqual(GetAggregateBruteForce(*x_values, *y_values, xmin, xmax, i == 36), columns[i]);
+
+        Add(total, columns[i]);
+    }
+
+    CheckEqual(curve.GetAggregateOverDomainInterval(0.0, 499.5), total);
+}
+
+BOOST_AUTO_TEST_CASE(MinMaxPolicyMatchesFull)
+{
+    const auto x_values = MakeXValues(300);
+    const auto y_values = MakeYValues<float>(300);
+
+    const plot::BasicAggregateCurve2D<float> full(x_values, y_values);
+    const plot::BasicAggregateCurve2D<float, plot::MinMaxAggregation> min_max(x_values, y_values);
+
+    for (double xmin = 0.0; xmin < 150.0; xmin += 4.5)
+    {
+        const Aggregate expected = full.GetAggregateOverDomainInterval(xmin, xmin + 12.0);
+        const plot::MinMax actual = min_max.GetAggregateOverDomainInterval(xmin, xmin + 12.0);
+
+        BOOST_REQUIRE_EQUAL(expected.IsEmpty(), actual.IsEmpty());
+        if (!expected.IsEmpty())
+        {
+            BOOST_CHECK_EQUAL(expected.min, actual.min);
+            BOOST_CHECK_EQUAL(expected.max, actual.max);
+        }
+    }
+
+    BOOST_CHECK(min_max.GetAggregateOverDomainInterval(100.0, 119.5).IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(MeanOfInterval)
+{
+    const AggregateCurve2D curve(
+        std::make_shared<std::vector<double>>(std::vector<double>{0, 1, 2, 3, 4}),
+        std::make_shared<std::vector<std::optional<double>>>(std::vector<std::optional<double>>{1.0, std::nullopt, 5.0, 3.0, 8.0})
+    );
+
+    const Aggregate aggregate = curve.GetAggregateOverDomainInterval(0.5, 3.0);
+    BOOST_CHECK_EQUAL(2, aggregate.count);
+    BOOST_CHECK_EQUAL(4.0, aggregate.GetMean());
+    BOOST_CHECK_EQUAL(5.0, aggregate.first);
+    BOOST_CHECK_EQUAL(3.0, aggregate.last);
+}
+
+BOOST_AUTO_TEST_CASE(AppendedAndReplacedValuesAreAggregated)
+{
+    const auto x_values = MakeXValues(300);
+    const auto y_values = MakeYValues<int16_t>(300);
+
+    plot::BuildOptions options;
+    options.leaf_size = 8;
+    plot::BasicAggregateCurve2D<int16_t> curve(
+        std::make_shared<std::vector<double>>(),
+        std::make_shared<std::vector<std::optional<int16_t>>>(),
+        options
+    );
+    for (size_t i = 0; i < x_values->size(); ++i)
+    {
+        curve.Append((*x_values)[i], (*y_values)[i]);
+    }
+
+    (*y_values)[17] = 500;
+    curve.SetValue(17, 500);
+    (*y_values)[250] = std::nullopt;
+    curve.SetValue(250, std::nullopt);
+
+    for (double xmin = -1.0; xmin < 151.0; xmin += 5.75)
+    {
+        CheckEqual(
+            GetAggregateBruteForce(*x_values, *y_values, xmin, xmin + 30.0, true),
+            curve.GetAggregateOverDomainInterval(xmin, xmin + 30.0)
+        );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
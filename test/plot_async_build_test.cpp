@@ -0,0 +1,118 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_async_build.hpp"
+#include "plot_explicit_2d.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using plot::BuildOptions;
+using plot::ExplicitSingleValueCurve2D;
+
+struct CurveValues
+{
+    std::shared_ptr<std::vector<double>> x_values = std::make_shared<std::vector<double>>();
+    std::shared_ptr<std::vector<std::optional<double>>> y_values = std::make_shared<std::vector<std::optional<double>>>();
+
+    explicit CurveValues(size_t num_values)
+    {
+        for (size_t i = 0; i < num_values; ++i)
+        {
+            x_values->push_back(i);
+            y_values->push_back(i % 6 == 1 ? std::nullopt : std::optional<double>((i * 83) % 107));
+        }
+    }
+
+    ExplicitSingleValueCurve2D operator()(const BuildOptions& options) const
+    {
+        return ExplicitSingleValueCurve2D(x_values, y_values, options);
+    }
+};
+
+/// Runs the tasks it is given when requested.
+struct ManualExecutor
+{
+    std::vector<std::function<void()>> tasks;
+
+    void RunAll()
+    {
+        for (auto& task: tasks) { task(); }
+        tasks.clear();
+    }
+};
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(AsyncBuildTests)
+
+BOOST_AUTO_TEST_CASE(AsyncCurveMatchesSynchronous)
+{
+    const CurveValues values(100'000);
+    const ExplicitSingleValueCurve2D expected = values(BuildOptions{});
+
+    auto build = plot::BuildAsync(values, BuildOptions{2});
+    const ExplicitSingleValueCurve2D curve = build.Get();
+
+    for (double xmin = -10.0; xmin < 100'000.0; xmin += 777.7)
+    {
+        BOOST_REQUIRE(expected.GetMinMaxOverDomainInterval(xmin, xmin + 5000.0) == curve.GetMinMaxOverDomainInterval(xmin, xmin + 5000.0));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(BuildRunsOnExecutor)
+{
+    const CurveValues values(1000);
+    ManualExecutor executor;
+
+    auto build = plot::BuildAsync(values, BuildOptions{}, [&](std::function<void()> task) { executor.tasks.push_back(std::move(task)); });
+    BOOST_REQUIRE_EQUAL(1, executor.tasks.size());
+    BOOST_CHECK(!build.IsReady());
+
+    executor.RunAll();
+    BOOST_REQUIRE(build.IsReady());
+    BOOST_CHECK(build.Get().GetMinMaxOverDomainInterval(0.0, 999.0) == std::make_tuple(0.0, 106.0));
+}
+
+BOOST_AUTO_TEST_CASE(CancelledBuildThrows)
+{
+    const CurveValues values(100'000);
+    ManualExecutor executor;
+
+    BuildOptions options;
+    options.leaf_size = 1;
+    auto build = plot::BuildAsync(values, options, [&](std::function<void()> task) { executor.tasks.push_back(std::move(task)); });
+
+    build.Cancel();
+    executor.RunAll();
+    BOOST_CHECK_THROW(build.Get(), plot::BuildCancelled);
+}
+
+BOOST_AUTO_TEST_CASE(CancellationFlagStopsConstructor)
+{
+    const CurveValues values(5000);
+
+    const std::atomic<bool> cancel{true};
+    BuildOptions options;
+    options.cancel = &cancel;
+    BOOST_CHECK_THROW(values(options), plot::BuildCancelled);
+
+    const std::atomic<bool> not_cancelled{false};
+    options.cancel = &not_cancelled;
+    ExplicitSingleValueCurve2D curve = values(options);
+
+    // the flag is not used after construction
+    curve.Append(5000.0, 1.0);
+    BOOST_CHECK_EQUAL(5001, curve.GetXValues().size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,121 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_column_cache.hpp"
+#include "plot_explicit_2d.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <optional>
+
+using plot::ColumnCache;
+using plot::ExplicitSingleValueCurve2D;
+
+static ExplicitSingleValueCurve2D MakeCurve()
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (int i = 0; i < 2000; ++i)
+    {
+        x_values->push_back(0.37 * i);
+        y_values->push_back(i % 11 == 6 ? std::nullopt : std::optional<double>((i * 71) % 211));
+    }
+
+    return ExplicitSingleValueCurve2D(x_values, y_values);
+}
+
+static void CheckColumns(
+    const ExplicitSingleValueCurve2D& curve,
+    double column_width,
+    int64_t first_column,
+    const ColumnCache<ExplicitSingleValueCurve2D>::Results& columns
+)
+{
+    std::vector<double> edges;
+    for (int64_t k = first_column; k <= first_column + static_cast<int64_t>(columns.size()); ++k)
+    {
+        edges.push_back(static_cast<double>(k) * column_width);
+    }
+
+    ColumnCache<ExplicitSingleValueCurve2D>::Results expected;
+    curve.GetMinMaxOverDomainColumns(edges, expected);
+    BOOST_REQUIRE(expected == columns);
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ColumnCacheTests)
+
+BOOST_AUTO_TEST_CASE(PanningReusesColumns)
+{
+    const ExplicitSingleValueCurve2D curve = MakeCurve();
+    ColumnCache<ExplicitSingleValueCurve2D> cache;
+
+    const double width = 1.3;
+    CheckColumns(curve, width, -20, cache.GetColumns(curve, width, -20, 300));
+    BOOST_CHECK_EQUAL(300, cache.GetNumComputedColumns());
+
+    // pan right, left, by more than the view, and resize
+    for (const auto& [first_column, num_columns, num_computed]: {
+        std::make_tuple(-15, 300, 5),
+        std::make_tuple(-15, 300, 0),
+        std::make_tuple(-40, 300, 25),
+        std::make_tuple(400, 300, 300),
+        std::make_tuple(410, 280, 0),
+        std::make_tuple(405, 300, 20)
+    })
+    {
+        const auto& columns = cache.GetColumns(curve, width, first_column, num_columns);
+        BOOST_CHECK_EQUAL(num_computed, cache.GetNumComputedColumns());
+        CheckColumns(curve, width, first_column, columns);
+    }
+
+    // zooming changes the column width
+    CheckColumns(curve, 2.0 * width, 200, cache.GetColumns(curve, 2.0 * width, 200, 300));
+    BOOST_CHECK_EQUAL(300, cache.GetNumComputedColumns());
+}
+
+BOOST_AUTO_TEST_CASE(ModifyingCurveInvalidatesCache)
+{
+    ExplicitSingleValueCurve2D curve = MakeCurve();
+    ColumnCache<ExplicitSingleValueCurve2D> cache;
+
+    cache.GetColumns(curve, 2.0, 0, 400);
+
+    curve.SetValue(100, 5000.0);
+    CheckColumns(curve, 2.0, 1, cache.GetColumns(curve, 2.0, 1, 400));
+    BOOST_CHECK_EQUAL(400, cache.GetNumComputedColumns());
+
+    curve.Append(10000.0, -1.0);
+    CheckColumns(curve, 2.0, 0, cache.GetColumns(curve, 2.0, 0, 400));
+    BOOST_CHECK_EQUAL(400, cache.GetNumComputedColumns());
+}
+
+BOOST_AUTO_TEST_CASE(NewCurveAtSameAddressInvalidatesCache)
+{
+    std::optional<ExplicitSingleValueCurve2D> curve;
+    ColumnCache<ExplicitSingleValueCurve2D> cache;
+
+    curve.emplace(MakeCurve());
+    const ExplicitSingleValueCurve2D* address = &*curve;
+    cache.GetColumns(*curve, 2.0, 0, 300);
+
+    // same address and version, but other values
+    curve.emplace(
+        std::make_shared<std::vector<double>>(curve->GetXValues()),
+        std::make_shared<std::vector<std::optional<double>>>(curve->GetXValues().size(), 7.0)
+    );
+    BOOST_REQUIRE_EQUAL(address, &*curve);
+
+    CheckColumns(*curve, 2.0, 0, cache.GetColumns(*curve, 2.0, 0, 300));
+    BOOST_CHECK_EQUAL(300, cache.GetNumComputedColumns());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
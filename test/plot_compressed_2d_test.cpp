@@ -0,0 +1,162 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_compressed_2d.hpp"
+#include "plot_explicit_2d.hpp"
+
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+using plot::CompressedExplicitSingleValueCurve2D;
+using plot::ExplicitSingleValueCurve2D;
+
+static std::shared_ptr<std::vector<double>> MakeXValues(size_t num_values)
+{
+    auto x_values = std::make_shared<std::vector<double>>();
+    for (size_t i = 0; i < num_values; ++i) { x_values->push_back(0.25 * i); }
+
+    return x_values;
+}
+
+/// Checks that both curves return the same values and query results.
+static void CheckSameAs(const CompressedExplicitSingleValueCurve2D& curve, const ExplicitSingleValueCurve2D& reference)
+{
+    const auto& y_values = reference.GetYValues();
+    BOOST_REQUIRE_EQUAL(y_values.size(), curve.GetNumValues());
+    for (size_t i = 0; i < y_values.size(); ++i)
+    {
+        const auto y = curve.GetY(i);
+        BOOST_REQUIRE_EQUAL(y_values[i].has_value(), y.has_value());
+        if (y.has_value()) { BOOST_REQUIRE_EQUAL(*y_values[i], *y); }
+    }
+
+    const double xmax = reference.GetXValues().empty() ? 1.0 : reference.GetXValues().back();
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<double> distribution(-1.0, xmax + 1.0);
+    for (int i = 0; i < 500; ++i)
+    {
+        double x1 = distribution(generator);
+        double x2 = distribution(generator);
+        if (x1 > x2) { std::swap(x1, x2); }
+
+        BOOST_REQUIRE(reference.GetMinMaxOverDomainInterval(x1, x2) == curve.GetMinMaxOverDomainInterval(x1, x2));
+    }
+
+    std::vector<std::optional<std::tuple<double, double>>> expected, actual;
+    reference.GetMinMaxOverDomainColumns(-0.3, xmax + 0.1, 37, expected);
+    curve.GetMinMaxOverDomainColumns(-0.3, xmax + 0.1, 37, actual);
+    BOOST_REQUIRE(expected == actual);
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(CompressedCurveTests)
+
+BOOST_AUTO_TEST_CASE(SmoothValuesMatchUncompressedCurve)
+{
+    const size_t NUM_VALUES = 5000;
+    auto x_values = MakeXValues(NUM_VALUES);
+    auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (size_t i = 0; i < NUM_VALUES; ++i)
+    {
+        y_values->push_back(i % 500 >= 100 && i % 500 < 120 ? std::nullopt : std::optional<double>(std::sin(0.01 * i)));
+    }
+
+    CompressedExplicitSingleValueCurve2D curve(x_values, *y_values, 64);
+    CheckSameAs(curve, ExplicitSingleValueCurve2D(x_values, y_values));
+}
+
+BOOST_AUTO_TEST_CASE(RandomValuesMatchUncompressedCurve)
+{
+    const size_t NUM_VALUES = 3001;
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> distribution(-1.0e6, 1.0e6);
+
+    auto x_values = MakeXValues(NUM_VALUES);
+    auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (size_t i = 0; i < NUM_VALUES; ++i)
+    {
+        y_values->push_back(i % 11 == 0 ? std::nullopt : std::optional<double>(distribution(generator)));
+    }
+
+    for (size_t block_size: {1, 2, 16, 128, 4096})
+    {
+        CompressedExplicitSingleValueCurve2D curve(x_values, *y_values, block_size);
+        CheckSameAs(curve, ExplicitSingleValueCurve2D(x_values, y_values));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SpecialValuesAreReproduced)
+{
+    const double INF = std::numeric_limits<double>::infinity();
+    auto x_values = MakeXValues(10);
+    auto y_values = std::make_shared<std::vector<std::optional<double>>>(std::vector<std::optional<double>>{
+        0.0, -0.0, INF, -INF, std::numeric_limits<double>::denorm_min(), std::nullopt,
+        std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(), 1.0, 1.0
+    });
+
+    CompressedExplicitSingleValueCurve2D curve(x_values, *y_values, 4);
+    for (size_t i = 0; i < y_values->size(); ++i)
+    {
+        BOOST_REQUIRE((*y_values)[i] == curve.GetY(i));
+    }
+    BOOST_CHECK(std::signbit(*curve.GetY(1)));
+    BOOST_CHECK(curve.GetMinMaxOverDomainInterval(1.5, 2.0) == std::make_tuple(std::numeric_limits<double>::lowest(), std::numeric_limits<double>::max()));
+
+    // NaN is treated as missing
+    CompressedExplicitSingleValueCurve2D with_nan(MakeXValues(2), {std::numeric_limits<double>::quiet_NaN(), 1.0}, 2);
+    BOOST_CHECK(!with_nan.GetY(0).has_value());
+    BOOST_CHECK(with_nan.GetMinMaxOverDomainInterval(0.0, 1.0) == std::make_tuple(1.0, 1.0));
+}
+
+BOOST_AUTO_TEST_CASE(EmptyCurveHasNoValues)
+{
+    CompressedExplicitSingleValueCurve2D curve(MakeXValues(0), {});
+    BOOST_CHECK_EQUAL(0, curve.GetNumValues());
+    BOOST_CHECK(!curve.GetMinMaxOverDomainInterval(0.0, 1.0).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(RepetitiveValuesAreCompressed)
+{
+    const size_t NUM_VALUES = 1 << 14;
+    std::vector<std::optional<double>> y_values;
+    for (size_t i = 0; i < NUM_VALUES; ++i)
+    {
+        // a slowly changing quantized signal, e.g. a sensor reading
+        y_values.push_back(std::round(100.0 * std::sin(0.001 * i)) / 4.0);
+    }
+
+    CompressedExplicitSingleValueCurve2D curve(MakeXValues(NUM_VALUES), y_values, 128);
+
+    // an uncompressed `std::optional<double>` takes 16 bytes
+    BOOST_CHECK_LT(curve.GetCompressedSize(), NUM_VALUES * 2);
+}
+
+BOOST_AUTO_TEST_CASE(CancellationFlagStopsConstructor)
+{
+    const std::vector<std::optional<double>> y_values(1000, 1.0);
+
+    const std::atomic<bool> cancel{true};
+    plot::BuildOptions options;
+    options.cancel = &cancel;
+    BOOST_CHECK_THROW(CompressedExplicitSingleValueCurve2D(MakeXValues(1000), y_values, 16, options), plot::BuildCancelled);
+
+    const std::atomic<bool> not_cancelled{false};
+    options.cancel = &not_cancelled;
+    CompressedExplicitSingleValueCurve2D curve(MakeXValues(1000), y_values, 16, options);
+    BOOST_CHECK(curve.GetMinMaxOverDomainInterval(0.0, 100.0) == std::make_tuple(1.0, 1.0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
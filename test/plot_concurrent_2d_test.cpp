@@ -0,0 +1,131 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_concurrent_2d.hpp"
+#include "plot_explicit_2d.hpp"
+
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <thread>
+
+using plot::ConcurrentExplicitSingleValueCurve2D;
+using plot::ExplicitSingleValueCurve2D;
+
+static std::optional<double> GetYValue(size_t i)
+{
+    return (i % 9 == 4 || (i >= 3000 && i < 3100)) ? std::nullopt : std::optional<double>((i * 7919) % 10007);
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ConcurrentCurveTests)
+
+BOOST_AUTO_TEST_CASE(AppendedValuesMatchExplicitCurve)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+
+    plot::BuildOptions options;
+    options.leaf_size = 4;
+    ConcurrentExplicitSingleValueCurve2D curve(options);
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        x_values->push_back(0.5 * i);
+        y_values->push_back(GetYValue(i));
+        curve.Append(x_values->back(), y_values->back());
+    }
+    BOOST_REQUIRE_EQUAL(1000, curve.GetNumValues());
+
+    const ExplicitSingleValueCurve2D expected(x_values, y_values, options);
+    for (double xmin = -2.1; xmin < 510.0; xmin += 3.3)
+    {
+        for (double width: {0.0, 0.3, 4.0, 77.7, 600.0})
+        {
+            BOOST_REQUIRE(expected.GetMinMaxOverDomainInterval(xmin, xmin + width) ==
+                          curve.GetMinMaxOverDomainInterval(xmin, xmin + width));
+        }
+    }
+
+    std::vector<std::optional<std::tuple<double, double>>> expected_columns, actual_columns;
+    expected.GetMinMaxOverDomainColumns(-1.0, 501.0, 123, expected_columns);
+    curve.GetMinMaxOverDomainColumns(-1.0, 501.0, 123, actual_columns);
+    BOOST_CHECK(expected_columns == actual_columns);
+
+    std::vector<plot::EnvelopePoint> expected_envelope, actual_envelope;
+    expected.GetEnvelope(10.0, 499.0, 37, expected_envelope);
+    curve.GetEnvelope(10.0, 499.0, 37, actual_envelope);
+    BOOST_REQUIRE_EQUAL(expected_envelope.size(), actual_envelope.size());
+    for (size_t i = 0; i < expected_envelope.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(expected_envelope[i].min, actual_envelope[i].min);
+        BOOST_CHECK_EQUAL(expected_envelope[i].max, actual_envelope[i].max);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ReadersSeeConsistentValuesDuringAppends)
+{
+    constexpr size_t NUM_VALUES = 20000;
+
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (size_t i = 0; i < NUM_VALUES; ++i)
+    {
+        x_values->push_back(i);
+        y_values->push_back(GetYValue(i));
+    }
+    const ExplicitSingleValueCurve2D expected(x_values, y_values);
+
+    for (size_t leaf_size: {1, 8})
+    {
+        plot::BuildOptions options;
+        options.leaf_size = leaf_size;
+        ConcurrentExplicitSingleValueCurve2D curve(options);
+
+        std::atomic<bool> done{false};
+        std::atomic<size_t> num_mismatches{0};
+
+        std::vector<std::thread> readers;
+        for (size_t r = 0; r < 2; ++r)
+        {
+            readers.emplace_back([&, r] {
+                size_t seed = r + 1;
+                while (!done)
+                {
+                    // any interval within the published values has the final result already
+                    const size_t num_values = curve.GetNumValues();
+                    if (num_values == 0) { continue; }
+
+                    seed = seed * 6364136223846793005u + 1442695040888963407u;
+                    const size_t lo = (seed >> 33) % num_values;
+                    const size_t hi = lo + (seed >> 17) % (num_values - lo);
+
+                    if (expected.GetMinMaxOverDomainInterval(lo, hi) != curve.GetMinMaxOverDomainInterval(lo, hi))
+                    {
+                        ++num_mismatches;
+                    }
+                }
+            });
+        }
+
+        for (size_t i = 0; i < NUM_VALUES; ++i)
+        {
+            curve.Append((*x_values)[i], (*y_values)[i]);
+        }
+        done = true;
+        for (auto& reader: readers) { reader.join(); }
+
+        BOOST_CHECK_EQUAL(0, num_mismatches);
+        BOOST_CHECK(expected.GetMinMaxOverDomainInterval(0, NUM_VALUES) == curve.GetMinMaxOverDomainInterval(0, NUM_VALUES));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
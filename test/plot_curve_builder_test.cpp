@@ -0,0 +1,170 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_curve_builder.hpp"
+
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using plot::DuplicateX;
+using plot::ExplicitCurveBuilder;
+using plot::InvalidCurveData;
+
+/// X values 0, 0.5, 1, ... and matching Y values (some missing).
+static void MakeValues(size_t num_values, std::vector<double>& x_values, std::vector<std::optional<double>>& y_values)
+{
+    x_values.clear();
+    y_values.clear();
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        x_values.push_back(0.5 * i);
+        y_values.push_back(i % 9 == 4 ? std::nullopt : std::optional<double>((i * 37) % 101));
+    }
+}
+
+/// Splits the values into `num_chunks` chunks. If `shuffle`, the values are distributed randomly and in any order;
+/// otherwise each chunk gets a contiguous range, and the chunks are added in reverse order.
+static ExplicitCurveBuilder MakeBuilder(
+    const std::vector<double>& x_values,
+    const std::vector<std::optional<double>>& y_values,
+    size_t num_chunks,
+    bool shuffle
+)
+{
+    std::vector<std::vector<double>> chunk_x(num_chunks);
+    std::vector<std::vector<std::optional<double>>> chunk_y(num_chunks);
+
+    std::vector<size_t> indices(x_values.size());
+    std::iota(indices.begin(), indices.end(), size_t{0});
+    std::mt19937 generator(7);
+    if (shuffle) { std::shuffle(indices.begin(), indices.end(), generator); }
+
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        const size_t chunk_idx = shuffle ? generator() % num_chunks : num_chunks - 1 - i * num_chunks / indices.size();
+        chunk_x[chunk_idx].push_back(x_values[indices[i]]);
+        chunk_y[chunk_idx].push_back(y_values[indices[i]]);
+    }
+
+    ExplicitCurveBuilder builder;
+    for (size_t i = 0; i < num_chunks; ++i) { builder.AddChunk(chunk_x[i], chunk_y[i]); }
+
+    return builder;
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(CurveBuilderTests)
+
+BOOST_AUTO_TEST_CASE(ChunksAreAssembledInOrderOfX)
+{
+    std::vector<double> x_values;
+    std::vector<std::optional<double>> y_values;
+    MakeValues(5000, x_values, y_values);
+
+    for (bool shuffle: {false, true})
+    {
+        for (size_t num_chunks: {1, 2, 7})
+        {
+            for (unsigned num_threads: {1, 4})
+            {
+                plot::BuildOptions options;
+                options.num_threads = num_threads;
+                const auto curve = MakeBuilder(x_values, y_values, num_chunks, shuffle).Build(options);
+
+                BOOST_REQUIRE(x_values == curve.GetXValues());
+                BOOST_REQUIRE(y_values == curve.GetYValues());
+                BOOST_REQUIRE(curve.GetMinMaxOverDomainInterval(0.0, 100.0) == std::make_tuple(0.0, 100.0));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(EmptyChunksAreSkipped)
+{
+    ExplicitCurveBuilder builder;
+    builder.AddChunk({}, {});
+    builder.AddChunk({2.0, 3.0}, {5.0, 6.0});
+    builder.AddChunk({}, {});
+    builder.AddChunk({0.0, 1.0}, {3.0, 4.0});
+
+    const auto curve = builder.Build();
+    BOOST_CHECK_EQUAL(0, builder.GetNumChunks());
+    BOOST_CHECK((std::vector<double>{0.0, 1.0, 2.0, 3.0}) == curve.GetXValues());
+    BOOST_CHECK((std::vector<std::optional<double>>{3.0, 4.0, 5.0, 6.0}) == curve.GetYValues());
+
+    BOOST_CHECK(ExplicitCurveBuilder().Build().GetXValues().empty());
+}
+
+BOOST_AUTO_TEST_CASE(DuplicatesAreResolvedAsRequested)
+{
+    for (DuplicateX duplicates: {DuplicateX::KeepFirst, DuplicateX::KeepLast})
+    {
+        plot::BasicExplicitCurveBuilder<int32_t> builder(duplicates);
+        builder.AddChunk({3.0, 1.0, 3.0, 2.0}, {1, 2, 3, 4});
+        builder.AddChunk({2.0, 4.0}, {5, 6});
+
+        const auto curve = builder.Build();
+        BOOST_CHECK((std::vector<double>{1.0, 2.0, 3.0, 4.0}) == curve.GetXValues());
+        if (duplicates == DuplicateX::KeepFirst)
+        {
+            BOOST_CHECK((std::vector<std::optional<int32_t>>{2, 4, 1, 6}) == curve.GetYValues());
+        }
+        else
+        {
+            BOOST_CHECK((std::vector<std::optional<int32_t>>{2, 5, 3, 6}) == curve.GetYValues());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(InvalidDataIsReported)
+{
+    const auto check_error = [](ExplicitCurveBuilder& builder, size_t chunk_idx, size_t value_idx) {
+        try
+        {
+            builder.Build();
+            BOOST_FAIL("InvalidCurveData not thrown");
+        }
+        catch (const InvalidCurveData& error)
+        {
+            BOOST_CHECK_EQUAL(chunk_idx, error.GetChunkIndex());
+            BOOST_CHECK_EQUAL(value_idx, error.GetValueIndex());
+        }
+        BOOST_CHECK_EQUAL(0, builder.GetNumChunks());
+    };
+
+    ExplicitCurveBuilder builder;
+    builder.AddChunk({0.0, 1.0}, {1.0, 1.0});
+    builder.AddChunk({2.0, std::numeric_limits<double>::quiet_NaN()}, {1.0, 1.0});
+    check_error(builder, 1, 1);
+
+    builder.AddChunk({0.0, std::numeric_limits<double>::infinity()}, {1.0, 1.0});
+    check_error(builder, 0, 1);
+
+    // repeated within a chunk
+    builder.AddChunk({0.0, 1.0}, {1.0, 1.0});
+    builder.AddChunk({5.0, 3.0, 5.0}, {1.0, 1.0, 1.0});
+    check_error(builder, 1, 2);
+
+    // repeated across chunks
+    builder.AddChunk({0.0, 1.0, 2.0}, {1.0, 1.0, 1.0});
+    builder.AddChunk({1.0}, {1.0});
+    check_error(builder, 1, 0);
+
+    BOOST_CHECK_THROW(builder.AddChunk({0.0, 1.0}, {1.0}), InvalidCurveData);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
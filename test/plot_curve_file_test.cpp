@@ -0,0 +1,158 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_curve_file.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+using plot::ExplicitSingleValueCurve2D;
+using plot::MappedExplicitSingleValueCurve2D;
+
+/// Removes the file on destruction.
+struct TemporaryFile
+{
+    std::string path;
+
+    explicit TemporaryFile(const std::string& name)
+    : path((std::filesystem::temp_directory_path() / name).string())
+    {}
+
+    ~TemporaryFile() { std::remove(path.c_str()); }
+};
+
+static ExplicitSingleValueCurve2D MakeCurve(size_t num_values, size_t leaf_size)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        x_values->push_back(0.5 * i);
+        y_values->push_back((i % 9 == 5 || (i >= 100 && i < 130)) ? std::nullopt : std::optional<double>((i * 43) % 101));
+    }
+
+    plot::BuildOptions options;
+    options.leaf_size = leaf_size;
+
+    return ExplicitSingleValueCurve2D(x_values, y_values, options);
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(CurveFileTests)
+
+BOOST_AUTO_TEST_CASE(MappedCurveMatchesOriginal)
+{
+    for (size_t leaf_size: {1, 2, 16})
+    {
+        const auto curve = MakeCurve(1000, leaf_size);
+        const TemporaryFile file("plot_test_curve.bin");
+        plot::WriteCurveFile(curve, file.path);
+
+        const MappedExplicitSingleValueCurve2D mapped(file.path);
+        BOOST_REQUIRE_EQUAL(1000, mapped.GetNumValues());
+
+        for (double xmin = -3.3; xmin < 510.0; xmin += 7.1)
+        {
+            for (double width: {0.1, 0.5, 2.25, 60.0, 600.0})
+            {
+                BOOST_REQUIRE(curve.GetMinMaxOverDomainInterval(xmin, xmin + width) ==
+                              mapped.GetMinMaxOverDomainInterval(xmin, xmin + width));
+            }
+        }
+
+        std::vector<std::optional<std::tuple<double, double>>> expected, actual;
+        curve.GetMinMaxOverDomainColumns(-10.0, 530.0, 333, expected);
+        mapped.GetMinMaxOverDomainColumns(-10.0, 530.0, 333, actual);
+        BOOST_CHECK(expected == actual);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(MappedEmptyCurve)
+{
+    const auto curve = MakeCurve(0, 2);
+    const TemporaryFile file("plot_test_empty_curve.bin");
+    plot::WriteCurveFile(curve, file.path);
+
+    const MappedExplicitSingleValueCurve2D mapped(file.path);
+    BOOST_CHECK(!mapped.GetMinMaxOverDomainInterval(-1.0, 1.0).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(MovedMappedCurve)
+{
+    const auto curve = MakeCurve(50, 2);
+    const TemporaryFile file("plot_test_moved_curve.bin");
+    plot::WriteCurveFile(curve, file.path);
+
+    MappedExplicitSingleValueCurve2D mapped(file.path);
+    MappedExplicitSingleValueCurve2D moved(std::move(mapped));
+    BOOST_CHECK(curve.GetMinMaxOverDomainInterval(1.0, 20.0) == moved.GetMinMaxOverDomainInterval(1.0, 20.0));
+}
+
+BOOST_AUTO_TEST_CASE(InvalidFilesAreRejected)
+{
+    BOOST_CHECK_THROW(MappedExplicitSingleValueCurve2D("/nonexistent/plot_curve.bin"), std::runtime_error);
+
+    const auto curve = MakeCurve(100, 2);
+    const TemporaryFile file("plot_test_invalid_curve.bin");
+
+    // corrupts one byte of a valid file at `offset`
+    const auto write_corrupted = [&](std::streamoff offset) {
+        plot::WriteCurveFile(curve, file.path);
+        std::fstream stream(file.path, std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekp(offset);
+        stream.put('\x7f');
+    };
+
+    write_corrupted(0); // magic
+    BOOST_CHECK_THROW(MappedExplicitSingleValueCurve2D{file.path}, std::runtime_error);
+
+    write_corrupted(8); // version
+    BOOST_CHECK_THROW(MappedExplicitSingleValueCurve2D{file.path}, std::runtime_error);
+
+    write_corrupted(12); // byte order mark
+    BOOST_CHECK_THROW(MappedExplicitSingleValueCurve2D{file.path}, std::runtime_error);
+
+    // truncated file
+    plot::WriteCurveFile(curve, file.path);
+    std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 8);
+    BOOST_CHECK_THROW(MappedExplicitSingleValueCurve2D{file.path}, std::runtime_error);
+
+    // truncated header
+    plot::WriteCurveFile(curve, file.path);
+    std::filesystem::resize_file(file.path, 40);
+    BOOST_CHECK_THROW(MappedExplicitSingleValueCurve2D{file.path}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(InconsistentHeaderIsRejected)
+{
+    // 5 values in leaves of 4 need 2 leaves
+    const auto curve = MakeCurve(5, 4);
+    const TemporaryFile file("plot_test_inconsistent_curve.bin");
+    plot::WriteCurveFile(curve, file.path);
+    BOOST_REQUIRE_NO_THROW(MappedExplicitSingleValueCurve2D{file.path});
+
+    // overwrite `num_leaves` (offset 32) with 1; the last value would then be read from a leaf past the tree
+    std::fstream stream(file.path, std::ios::binary | std::ios::in | std::ios::out);
+    const uint64_t num_leaves = 1;
+    stream.seekp(32);
+    stream.write(reinterpret_cast<const char*>(&num_leaves), sizeof(num_leaves));
+    stream.close();
+
+    BOOST_CHECK_THROW(MappedExplicitSingleValueCurve2D{file.path}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -7,12 +7,18 @@
 //
 
 #define BOOST_TEST_DYN_LINK
-#define BOOST_TEST_MODULE PlotExplicit2D
 
 #include "plot_explicit_2d.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <thread>
 
 using plot::ExplicitSingleValueCurve2D;
 
@@ -26,6 +32,27 @@ static std::shared_ptr<std::vector<std::optional<double>>> MakeOptionalDoubleVec
     return std::make_shared<std::vector<std::optional<double>>>(values);
 }
 
+/// Counts the allocations made through it.
+class CountingResource: public std::pmr::memory_resource
+{
+public:
+    size_t num_allocations{0};
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++num_allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
 // ---------------------------- Test cases -------------------------------------------
 
 BOOST_AUTO_TEST_CASE(Interpolation)
@@ -359,3 +386,529 @@ BOOST_AUTO_TEST_CASE(InterpolateWithEmptyInterval)
     BOOST_CHECK_EQUAL(1.25, std::get<0>(min_max.value()));
     BOOST_CHECK_EQUAL(1.75, std::get<1>(min_max.value()));
 }
+
+BOOST_AUTO_TEST_CASE(ColumnsMatchSingleQueries)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+
+    for (int i = 0; i < 100; ++i)
+    {
+        x_values->push_back(i);
+        if (i % 7 == 3 || (i >= 40 && i < 50))
+        {
+            y_values->push_back(std::nullopt);
+        }
+        else
+        {
+            y_values->push_back((i * 37) % 23);
+        }
+    }
+
+    ExplicitSingleValueCurve2D plot(x_values, y_values);
+
+    // columns extend past both ends of the curve; some column edges coincide with `x_values`
+    const double xmin = -10.0;
+    const double xmax = 110.0;
+    const size_t num_columns = 96;
+
+    std::vector<std::optional<std::tuple<double, double>>> columns;
+    plot.GetMinMaxOverDomainColumns(xmin, xmax, num_columns, columns);
+    BOOST_REQUIRE_EQUAL(num_columns, columns.size());
+
+    for (size_t i = 0; i < num_columns; ++i)
+    {
+        const double column_start = xmin + (xmax - xmin) * i / num_columns;
+        const double column_end = (i + 1 == num_columns) ? xmax : xmin + (xmax - xmin) * (i + 1) / num_columns;
+
+        const auto expected = plot.GetMinMaxOverDomainInterval(column_start, column_end);
+        BOOST_REQUIRE_EQUAL(expected.has_value(), columns[i].has_value());
+        if (expected.has_value())
+        {
+            BOOST_CHECK_EQUAL(std::get<0>(*expected), std::get<0>(*columns[i]));
+            BOOST_CHECK_EQUAL(std::get<1>(*expected), std::get<1>(*columns[i]));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ColumnsWithExplicitEdges)
+{
+    // Vertical lines mark the column edges passed to `GetMinMaxOverDomainColumns()`.
+    //
+    // o - plot points
+    // * - interpolated plot points
+    //
+    //  y:
+    //             |       |       |
+    //  2          |       |   o   |
+    //  1.5        |       *       |
+    //  1          |   o   |       |
+    //  0.5        *       |       |
+    //  0      o   |       |       |
+    //
+    // x:      0  0.5  1  1.5  2  2.5
+    //
+
+    const auto x_values = MakeDoubleVectorPtr({0, 1, 2});
+    const auto y_values = MakeOptionalDoubleVectorPtr({0, 1, 2});
+
+    ExplicitSingleValueCurve2D plot(x_values, y_values);
+
+    std::vector<std::optional<std::tuple<double, double>>> columns;
+    plot.GetMinMaxOverDomainColumns({0.5, 1.5, 2.5}, columns);
+    BOOST_REQUIRE_EQUAL(2, columns.size());
+
+    BOOST_CHECK_EQUAL(0.5, std::get<0>(columns[0].value()));
+    BOOST_CHECK_EQUAL(1.5, std::get<1>(columns[0].value()));
+    BOOST_CHECK_EQUAL(1.5, std::get<0>(columns[1].value()));
+    BOOST_CHECK_EQUAL(2.0, std::get<1>(columns[1].value()));
+}
+
+BOOST_AUTO_TEST_CASE(SingleValue)
+{
+    const auto x_values = MakeDoubleVectorPtr({1});
+    const auto y_values = MakeOptionalDoubleVectorPtr({5});
+
+    ExplicitSingleValueCurve2D plot(x_values, y_values);
+    const std::optional<std::tuple<double, double>> min_max = plot.GetMinMaxOverDomainInterval(0.0, 2.0);
+
+    BOOST_CHECK_EQUAL(5.0, std::get<0>(min_max.value()));
+    BOOST_CHECK_EQUAL(5.0, std::get<1>(min_max.value()));
+}
+
+BOOST_AUTO_TEST_CASE(AppendToEmptyCurve)
+{
+    ExplicitSingleValueCurve2D plot(
+        std::make_shared<std::vector<double>>(),
+        std::make_shared<std::vector<std::optional<double>>>()
+    );
+    BOOST_CHECK(!plot.GetMinMaxOverDomainInterval(0.0, 10.0).has_value());
+
+    plot.Append(0.0, 3.0);
+    plot.Append(1.0, std::nullopt);
+    plot.Append(2.0, -1.0);
+
+    const std::optional<std::tuple<double, double>> min_max = plot.GetMinMaxOverDomainInterval(0.0, 10.0);
+    BOOST_CHECK_EQUAL(-1.0, std::get<0>(min_max.value()));
+    BOOST_CHECK_EQUAL(3.0, std::get<1>(min_max.value()));
+    BOOST_CHECK_EQUAL(3, plot.GetXValues().size());
+}
+
+BOOST_AUTO_TEST_CASE(AppendMatchesConstruction)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    ExplicitSingleValueCurve2D appended(x_values, y_values);
+
+    std::vector<double> batch_x;
+    std::vector<std::optional<double>> batch_y;
+
+    for (int i = 0; i < 300; ++i)
+    {
+        const std::optional<double> y = (i % 5 == 2) ? std::nullopt : std::optional<double>((i * 53) % 97);
+
+        if (i < 200)
+        {
+            appended.Append(i, y);
+        }
+        else
+        {
+            // append the rest in batches, each crossing a different position within the tree
+            batch_x.push_back(i);
+            batch_y.push_back(y);
+            if (batch_x.size() == 17 || i == 299)
+            {
+                appended.AppendBatch(batch_x, batch_y);
+                batch_x.clear();
+                batch_y.clear();
+            }
+        }
+
+        // queries keep working while values are being appended
+        if (i % 10 == 0)
+        {
+            ExplicitSingleValueCurve2D constructed(
+                std::make_shared<std::vector<double>>(*x_values),
+                std::make_shared<std::vector<std::optional<double>>>(*y_values)
+            );
+
+            for (double xmin = -0.5; xmin < i; xmin += 3.25)
+            {
+                const auto expected = constructed.GetMinMaxOverDomainInterval(xmin, xmin + 20.0);
+                const auto actual = appended.GetMinMaxOverDomainInterval(xmin, xmin + 20.0);
+                BOOST_REQUIRE_EQUAL(expected.has_value(), actual.has_value());
+                if (expected.has_value())
+                {
+                    BOOST_CHECK_EQUAL(std::get<0>(*expected), std::get<0>(*actual));
+                    BOOST_CHECK_EQUAL(std::get<1>(*expected), std::get<1>(*actual));
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_EQUAL(300, x_values->size());
+}
+
+BOOST_AUTO_TEST_CASE(ParallelBuildMatchesSerial)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+
+    for (int i = 0; i < 300'000; ++i)
+    {
+        x_values->push_back(i);
+        y_values->push_back(i % 11 == 0 ? std::nullopt : std::optional<double>((i * 7919) % 100'003));
+    }
+
+    ExplicitSingleValueCurve2D serial(x_values, y_values);
+    ExplicitSingleValueCurve2D parallel(x_values, y_values, plot::BuildOptions{3});
+
+    for (double xmin = -5.5; xmin < 300'000; xmin += 1234.5)
+    {
+        for (double width: {0.5, 3.0, 100.0, 70'000.0})
+        {
+            const auto expected = serial.GetMinMaxOverDomainInterval(xmin, xmin + width);
+            const auto actual = parallel.GetMinMaxOverDomainInterval(xmin, xmin + width);
+            BOOST_REQUIRE(expected == actual);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(LeafSizes)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+
+    for (int i = 0; i < 150; ++i)
+    {
+        x_values->push_back(i);
+        y_values->push_back((i % 13 == 4 || (i >= 60 && i < 95)) ? std::nullopt : std::optional<double>((i * 61) % 89));
+    }
+
+    for (size_t leaf_size: {1, 2, 16, 32})
+    {
+        plot::BuildOptions options;
+        options.leaf_size = leaf_size;
+        ExplicitSingleValueCurve2D plot(x_values, y_values, options);
+
+        // with integer bounds there is no interpolation, so the result is the min and max of `y_values` in [lo, hi]
+        for (int lo = 0; lo < 150; ++lo)
+        {
+            for (int hi = lo; hi < 150; hi += 1 + hi % 5)
+            {
+                std::optional<std::tuple<double, double>> expected;
+                for (int i = lo; i <= hi; ++i)
+                {
+                    if (!(*y_values)[i].has_value()) { continue; }
+
+                    const double value = *(*y_values)[i];
+                    expected = expected.has_value()
+                        ? std::make_tuple(std::min(std::get<0>(*expected), value), std::max(std::get<1>(*expected), value))
+                        : std::make_tuple(value, value);
+                }
+
+                BOOST_REQUIRE(expected == plot.GetMinMaxOverDomainInterval(lo, hi));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SizesAroundPowersOf2)
+{
+    for (size_t size = 1; size <= 70; ++size)
+    {
+        const auto x_values = std::make_shared<std::vector<double>>();
+        const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+        for (size_t i = 0; i < size; ++i)
+        {
+            x_values->push_back(i);
+            y_values->push_back(static_cast<double>((i * 17) % 23));
+        }
+
+        const double expected_min = **std::min_element(y_values->begin(), y_values->end());
+        const double expected_max = **std::max_element(y_values->begin(), y_values->end());
+
+        for (size_t leaf_size: {1, 2, 4, 8})
+        {
+            plot::BuildOptions options;
+            options.leaf_size = leaf_size;
+            ExplicitSingleValueCurve2D plot(x_values, y_values, options);
+
+            const auto min_max = plot.GetMinMaxOverDomainInterval(0.0, size - 1);
+            BOOST_REQUIRE_EQUAL(expected_min, std::get<0>(min_max.value()));
+            BOOST_REQUIRE_EQUAL(expected_max, std::get<1>(min_max.value()));
+
+            const auto last = plot.GetMinMaxOverDomainInterval(size - 1, size - 1);
+            BOOST_REQUIRE_EQUAL(*y_values->back(), std::get<0>(last.value()));
+        }
+    }
+}
+
+/// Checks that a curve storing Y values as `T` gives the same results as one storing them as `double`.
+template<typename T>
+static void CheckNarrowValueType()
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    const auto narrow_y_values = std::make_shared<std::vector<std::optional<T>>>();
+
+    for (int i = 0; i < 200; ++i)
+    {
+        x_values->push_back(0.5 * i);
+
+        // includes the extreme values, which the tree of an integer type also uses to mark empty nodes
+        std::optional<T> value;
+        if (i == 17) { value = std::numeric_limits<T>::max(); }
+        else if (i == 151) { value = std::numeric_limits<T>::lowest(); }
+        else if (i % 11 != 3 && !(i >= 80 && i < 112)) { value = static_cast<T>(((i * 53) % 211) - 100); }
+
+        narrow_y_values->push_back(value);
+        y_values->push_back(value.has_value() ? std::optional<double>(*value) : std::nullopt);
+    }
+
+    plot::BuildOptions options;
+    options.leaf_size = 4;
+
+    const ExplicitSingleValueCurve2D expected(x_values, y_values, options);
+    const plot::BasicExplicitSingleValueCurve2D<T> curve(x_values, narrow_y_values, options);
+
+    for (double xmin = -1.3; xmin < 101.0; xmin += 0.35)
+    {
+        for (double width: {0.0, 0.2, 1.75, 8.0, 50.0})
+        {
+            BOOST_REQUIRE(expected.GetMinMaxOverDomainInterval(xmin, xmin + width) ==
+                          curve.GetMinMaxOverDomainInterval(xmin, xmin + width));
+        }
+    }
+
+    // an interval of empty values only
+    BOOST_CHECK(!curve.GetMinMaxOverDomainInterval(40.0, 55.5).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(NarrowValueTypes)
+{
+    CheckNarrowValueType<float>();
+    CheckNarrowValueType<int32_t>();
+    CheckNarrowValueType<int16_t>();
+}
+
+BOOST_AUTO_TEST_CASE(EnvelopeBlocksMatchValues)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (int i = 0; i < 1000; ++i)
+    {
+        x_values->push_back(2.0 * i);
+        y_values->push_back((i % 10 == 7 || (i >= 192 && i < 256)) ? std::nullopt : std::optional<double>((i * 67) % 139));
+    }
+
+    for (size_t leaf_size: {1, 4, 256})
+    {
+        plot::BuildOptions options;
+        options.leaf_size = leaf_size;
+        const ExplicitSingleValueCurve2D plot(x_values, y_values, options);
+
+        // 100 values per column: blocks of 64 values; block 3 has no values
+        std::vector<plot::EnvelopePoint> envelope;
+        plot.GetEnvelope(0.0, 1998.0, 10, envelope);
+        BOOST_REQUIRE_EQUAL(15, envelope.size());
+
+        for (size_t i = 0; i < envelope.size(); ++i)
+        {
+            const size_t block = i < 3 ? i : i + 1;
+            const size_t first_idx = block * 64;
+            const size_t last_idx = std::min(first_idx + 64, x_values->size()) - 1;
+
+            plot::MinMax expected = plot::MinMax::Empty();
+            for (size_t j = first_idx; j <= last_idx; ++j)
+            {
+                if ((*y_values)[j].has_value()) { expected.Add(*(*y_values)[j]); }
+            }
+
+            BOOST_CHECK_EQUAL(0.5 * ((*x_values)[first_idx] + (*x_values)[last_idx]), envelope[i].x);
+            BOOST_CHECK_EQUAL(expected.min, envelope[i].min);
+            BOOST_CHECK_EQUAL(expected.max, envelope[i].max);
+        }
+
+        // fewer values than columns: each non-empty value is a point
+        plot.GetEnvelope(101.0, 131.0, 500, envelope);
+        BOOST_REQUIRE_EQUAL(14, envelope.size());
+        for (const auto& point: envelope)
+        {
+            const auto& value = (*y_values)[static_cast<size_t>(point.x / 2.0)];
+            BOOST_REQUIRE(value.has_value());
+            BOOST_CHECK_EQUAL(*value, point.min);
+            BOOST_CHECK_EQUAL(*value, point.max);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(EnvelopeSizeDependsOnWidthOnly)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (int i = 0; i < 100000; ++i)
+    {
+        x_values->push_back(i);
+        y_values->push_back(static_cast<double>((i * 7919) % 10007));
+    }
+    const ExplicitSingleValueCurve2D plot(x_values, y_values);
+
+    std::vector<plot::EnvelopePoint> envelope;
+    for (const auto& [xmin, xmax]: {std::make_tuple(0.0, 99999.0), std::make_tuple(1234.5, 7777.7), std::make_tuple(-10.0, 40000.0)})
+    {
+        for (size_t width: {1, 7, 300, 1920})
+        {
+            plot.GetEnvelope(xmin, xmax, width, envelope);
+            BOOST_REQUIRE(!envelope.empty());
+            BOOST_CHECK_LE(envelope.size(), 2 * width + 2);
+
+            for (size_t i = 1; i < envelope.size(); ++i)
+            {
+                BOOST_REQUIRE_LT(envelope[i - 1].x, envelope[i].x);
+            }
+
+            // the envelope covers all values in [xmin, xmax]
+            const auto min_max = plot.GetMinMaxOverDomainInterval(std::ceil(xmin), std::floor(xmax));
+            double envelope_min = envelope[0].min;
+            double envelope_max = envelope[0].max;
+            for (const auto& point: envelope)
+            {
+                envelope_min = std::min(envelope_min, point.min);
+                envelope_max = std::max(envelope_max, point.max);
+            }
+            BOOST_CHECK_LE(envelope_min, std::get<0>(min_max.value()));
+            BOOST_CHECK_GE(envelope_max, std::get<1>(min_max.value()));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SetValuesMatchesConstruction)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (int i = 0; i < 300; ++i)
+    {
+        x_values->push_back(i);
+        y_values->push_back(static_cast<double>((i * 41) % 97));
+    }
+
+    for (size_t leaf_size: {1, 2, 8})
+    {
+        plot::BuildOptions options;
+        options.leaf_size = leaf_size;
+
+        const auto modified_y_values = std::make_shared<std::vector<std::optional<double>>>(*y_values);
+        ExplicitSingleValueCurve2D plot(x_values, modified_y_values, options);
+
+        plot.SetValue(0, 1000.0);
+        plot.SetValue(299, std::nullopt);
+        plot.SetValue(150, -5.0);
+
+        // masks a burst of values across several leaves
+        plot.SetRange(37, std::vector<std::optional<double>>(60, std::nullopt));
+        plot.SetRange(200, {-7.0, 2000.0, std::nullopt});
+
+        const ExplicitSingleValueCurve2D expected(
+            x_values, std::make_shared<std::vector<std::optional<double>>>(*modified_y_values), options
+        );
+        BOOST_REQUIRE((*modified_y_values)[36].has_value() && !(*modified_y_values)[96].has_value());
+
+        for (int lo = 0; lo < 300; lo += 3)
+        {
+            for (int hi = lo; hi < 300; hi += 1 + hi % 7)
+            {
+                BOOST_REQUIRE(expected.GetMinMaxOverDomainInterval(lo, hi) == plot.GetMinMaxOverDomainInterval(lo, hi));
+            }
+        }
+
+        BOOST_CHECK(!plot.GetMinMaxOverDomainInterval(37.0, 96.0).has_value());
+        BOOST_CHECK(plot.GetMinMaxOverDomainInterval(0.0, 299.0) == std::make_tuple(-7.0, 2000.0));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(RebuildMatchesConstruction)
+{
+    CountingResource resource;
+    plot::BuildOptions options;
+    options.memory_resource = &resource;
+
+    ExplicitSingleValueCurve2D plot(std::make_shared<std::vector<double>>(), std::make_shared<std::vector<std::optional<double>>>(), options);
+    BOOST_CHECK_EQUAL(1, resource.num_allocations);
+
+    for (int num_values: {200, 150, 40, 500})
+    {
+        const auto x_values = std::make_shared<std::vector<double>>();
+        const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+        for (int i = 0; i < num_values; ++i)
+        {
+            x_values->push_back(0.5 * i);
+            y_values->push_back(i % 7 == 3 ? std::nullopt : std::optional<double>((i * 31 + num_values) % 89));
+        }
+
+        const size_t num_allocations = resource.num_allocations;
+        const size_t capacity = plot.GetTree().GetCapacity();
+        plot.Rebuild(x_values, y_values);
+
+        // the tree is reallocated only when it grows
+        const bool grows = plot.GetTree().GetNumLeaves() > capacity;
+        BOOST_CHECK_EQUAL(num_allocations + (grows ? 1 : 0), resource.num_allocations);
+
+        const ExplicitSingleValueCurve2D expected(x_values, y_values);
+        for (double lo = -1.0; lo < 0.5 * num_values; lo += 2.75)
+        {
+            for (double width: {0.2, 1.0, 12.5, 300.0})
+            {
+                BOOST_REQUIRE(expected.GetMinMaxOverDomainInterval(lo, lo + width) == plot.GetMinMaxOverDomainInterval(lo, lo + width));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(LazyCurveMatchesEager)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (int i = 0; i < 5000; ++i)
+    {
+        x_values->push_back(i);
+        y_values->push_back(i % 9 == 2 ? std::nullopt : std::optional<double>((i * 67) % 113));
+    }
+
+    plot::BuildOptions options;
+    options.lazy = true;
+    options.build_x_index = true;
+
+    const ExplicitSingleValueCurve2D eager(x_values, y_values);
+    const ExplicitSingleValueCurve2D lazy(x_values, y_values, options);
+
+    // the first queries race to build the tree
+    std::atomic<size_t> num_mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (double xmin = -1.5 + t; xmin < 5000.0; xmin += 97.25)
+            {
+                if (eager.GetMinMaxOverDomainInterval(xmin, xmin + 250.0) != lazy.GetMinMaxOverDomainInterval(xmin, xmin + 250.0))
+                {
+                    ++num_mismatches;
+                }
+            }
+        });
+    }
+    for (auto& thread: threads) { thread.join(); }
+
+    BOOST_CHECK_EQUAL(0, num_mismatches);
+
+    BOOST_CHECK_EQUAL(eager.GetTree().GetNumNodes(), lazy.GetTree().GetNumNodes());
+
+    // modifications of a curve not yet built
+    ExplicitSingleValueCurve2D appended(
+        std::make_shared<std::vector<double>>(*x_values),
+        std::make_shared<std::vector<std::optional<double>>>(*y_values),
+        options
+    );
+    appended.Append(5000.0, 1000.0);
+    BOOST_CHECK(appended.GetMinMaxOverDomainInterval(4990.0, 5000.0) == std::make_tuple(1.0, 1000.0));
+}
@@ -0,0 +1,96 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_explicit_2d.hpp"
+#include "plot_inline_2d.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+using plot::InlineExplicitCurve2D;
+
+template<typename T>
+static std::shared_ptr<std::vector<std::optional<T>>> MakeYValues(size_t num_values)
+{
+    auto y_values = std::make_shared<std::vector<std::optional<T>>>();
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        y_values->push_back((i % 7 == 3 || (i >= 100 && i < 130)) ? std::nullopt : std::optional<T>((i * 59) % 97));
+    }
+
+    return y_values;
+}
+
+static std::shared_ptr<std::vector<double>> MakeXValues(size_t num_values)
+{
+    auto x_values = std::make_shared<std::vector<double>>();
+    for (size_t i = 0; i < num_values; ++i) { x_values->push_back(0.5 * i + 0.01 * (i % 3)); }
+
+    return x_values;
+}
+
+/// Checks that `Curve` returns the same results as `BasicExplicitSingleValueCurve2D<T>`.
+template<typename T, typename Curve>
+static void CheckSameAsExplicit(size_t num_values)
+{
+    auto x_values = MakeXValues(num_values);
+    auto y_values = MakeYValues<T>(num_values);
+
+    const Curve curve(x_values, y_values);
+    const plot::BasicExplicitSingleValueCurve2D<T> reference(x_values, y_values);
+
+    std::mt19937 generator(num_values);
+    std::uniform_real_distribution<double> distribution(-2.0, 0.5 * num_values + 2.0);
+    for (int i = 0; i < 2000; ++i)
+    {
+        const double x1 = distribution(generator);
+        const double x2 = distribution(generator);
+
+        // including xmin > xmax
+        BOOST_REQUIRE(reference.GetMinMaxOverDomainInterval(x1, x2) == curve.GetMinMaxOverDomainInterval(x1, x2));
+    }
+    for (size_t i = 0; i + 2 < num_values; ++i)
+    {
+        BOOST_REQUIRE(reference.GetMinMaxOverDomainInterval((*x_values)[i], (*x_values)[i + 2])
+            == curve.GetMinMaxOverDomainInterval((*x_values)[i], (*x_values)[i + 2]));
+    }
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(InlineCurveTests)
+
+BOOST_AUTO_TEST_CASE(ResultsMatchExplicitCurve)
+{
+    for (size_t num_values: {0, 1, 2, 7, 300, 1025})
+    {
+        CheckSameAsExplicit<double, InlineExplicitCurve2D<double>>(num_values);
+        CheckSameAsExplicit<double, InlineExplicitCurve2D<double, 1>>(num_values);
+        CheckSameAsExplicit<float, InlineExplicitCurve2D<float, 32>>(num_values);
+        CheckSameAsExplicit<int16_t, InlineExplicitCurve2D<int16_t, 4>>(num_values);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(FixedCapacityCurveMatchesExplicitCurve)
+{
+    using Curve = InlineExplicitCurve2D<double, 16, 128>;
+    static_assert(Curve::MAX_VALUES == 2048);
+
+    for (size_t num_values: {0, 1, 500, 2048})
+    {
+        CheckSameAsExplicit<double, Curve>(num_values);
+        BOOST_CHECK_EQUAL(128, Curve(MakeXValues(num_values), MakeYValues<double>(num_values)).GetNumLeaves());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
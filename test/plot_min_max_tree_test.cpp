@@ -0,0 +1,216 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_min_max_tree.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using plot::MinMax;
+using plot::MinMaxTree;
+
+/// Returns leaf values with some empty leaves.
+static std::vector<MinMax> MakeLeaves(size_t num_leaves)
+{
+    std::vector<MinMax> leaves;
+    for (size_t i = 0; i < num_leaves; ++i)
+    {
+        if (i % 5 == 3)
+        {
+            leaves.push_back(MinMax::Empty());
+        }
+        else
+        {
+            const double value = static_cast<double>((i * 29) % 31);
+            leaves.push_back({value, value + static_cast<double>(i % 4)});
+        }
+    }
+
+    return leaves;
+}
+
+static MinMax GetMinMaxBruteForce(const std::vector<MinMax>& leaves, size_t first_leaf, size_t last_leaf)
+{
+    MinMax result = MinMax::Empty();
+    for (size_t i = first_leaf; i <= last_leaf; ++i)
+    {
+        result.Add(leaves[i]);
+    }
+
+    return result;
+}
+
+static void CheckAllLeafIntervals(const MinMaxTree& tree, const std::vector<MinMax>& leaves)
+{
+    for (size_t first = 0; first < leaves.size(); ++first)
+    {
+        for (size_t last = first; last < leaves.size(); ++last)
+        {
+            const MinMax expected = GetMinMaxBruteForce(leaves, first, last);
+
+            for (const MinMax& actual: { tree.GetMinMaxOverLeafInterval(first, last),
+                                         tree.GetMinMaxOverLeafIntervalRecursive(first, last) })
+            {
+                BOOST_REQUIRE_EQUAL(expected.IsEmpty(), actual.IsEmpty());
+                if (!expected.IsEmpty())
+                {
+                    BOOST_REQUIRE_EQUAL(expected.min, actual.min);
+                    BOOST_REQUIRE_EQUAL(expected.max, actual.max);
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(MinMaxTreeTests)
+
+BOOST_AUTO_TEST_CASE(NewTreeIsEmpty)
+{
+    MinMaxTree tree(8);
+    BOOST_CHECK_EQUAL(15, tree.GetNumNodes());
+    BOOST_CHECK(tree.GetMinMaxOverLeafInterval(0, 7).IsEmpty());
+    BOOST_CHECK(tree.GetMinMaxOverLeafInterval(2, 5).IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(AllLeafIntervals)
+{
+    for (size_t num_leaves: {1, 2, 4, 32})
+    {
+        const auto leaves = MakeLeaves(num_leaves);
+        MinMaxTree tree(num_leaves);
+        for (size_t i = 0; i < num_leaves; ++i) { tree.SetLeaf(i, leaves[i]); }
+        tree.FillInternalNodes();
+
+        CheckAllLeafIntervals(tree, leaves);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(UpdateAncestorsOfLeafRange)
+{
+    auto leaves = MakeLeaves(64);
+    MinMaxTree tree(64);
+    for (size_t i = 0; i < leaves.size(); ++i) { tree.SetLeaf(i, leaves[i]); }
+    tree.FillInternalNodes();
+
+    for (size_t i = 13; i <= 37; ++i)
+    {
+        leaves[i] = (i % 3 == 0) ? MinMax::Empty() : MinMax{-static_cast<double>(i), static_cast<double>(2 * i)};
+        tree.SetLeaf(i, leaves[i]);
+    }
+    tree.UpdateAncestors(13, 37);
+
+    CheckAllLeafIntervals(tree, leaves);
+}
+
+BOOST_AUTO_TEST_CASE(InfiniteValuesAreNotEmpty)
+{
+    MinMaxTree tree(2);
+    tree.SetLeaf(0, {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()});
+    tree.FillInternalNodes();
+
+    BOOST_CHECK(!tree.GetMinMaxOverLeafInterval(0, 1).IsEmpty());
+    BOOST_CHECK(tree.GetMinMaxOverLeafInterval(1, 1).IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(ExtremeIntegerValuesAreNotEmpty)
+{
+    plot::BasicMinMaxTree<int16_t> tree(4);
+    tree.SetLeaf(0, {std::numeric_limits<int16_t>::max(), std::numeric_limits<int16_t>::max()});
+    tree.SetLeaf(2, {std::numeric_limits<int16_t>::lowest(), std::numeric_limits<int16_t>::lowest()});
+    tree.FillInternalNodes();
+
+    BOOST_CHECK(!tree.GetMinMaxOverLeafInterval(0, 0).IsEmpty());
+    BOOST_CHECK(tree.GetMinMaxOverLeafInterval(1, 1).IsEmpty());
+
+    const auto min_max = tree.GetMinMaxOverLeafInterval(0, 3);
+    BOOST_CHECK_EQUAL(std::numeric_limits<int16_t>::lowest(), min_max.min);
+    BOOST_CHECK_EQUAL(std::numeric_limits<int16_t>::max(), min_max.max);
+}
+
+BOOST_AUTO_TEST_CASE(ParallelFillIsIdenticalToSerial)
+{
+    const size_t num_leaves = size_t{1} << 17;
+    const auto leaves = MakeLeaves(num_leaves);
+
+    MinMaxTree serial(num_leaves);
+    MinMaxTree parallel(num_leaves);
+    for (size_t i = 0; i < num_leaves; ++i)
+    {
+        serial.SetLeaf(i, leaves[i]);
+        parallel.SetLeaf(i, leaves[i]);
+    }
+    serial.FillInternalNodes();
+    parallel.FillInternalNodes(5);
+
+    for (size_t i = 0; i < serial.GetNumNodes(); ++i)
+    {
+        BOOST_REQUIRE_EQUAL(serial.GetNode(i).min, parallel.GetNode(i).min);
+        BOOST_REQUIRE_EQUAL(serial.GetNode(i).max, parallel.GetNode(i).max);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(NumLeavesAtBoundarySizes)
+{
+    BOOST_CHECK_EQUAL(1, MinMaxTree::GetNumLeavesFor(0, 2));
+    BOOST_CHECK_EQUAL(1, MinMaxTree::GetNumLeavesFor(1, 2));
+    BOOST_CHECK_EQUAL(1, MinMaxTree::GetNumLeavesFor(2, 2));
+    BOOST_CHECK_EQUAL(2, MinMaxTree::GetNumLeavesFor(3, 2));
+    BOOST_CHECK_EQUAL(4, MinMaxTree::GetNumLeavesFor(33, 16));
+
+    if constexpr (sizeof(size_t) >= 8)
+    {
+        const size_t two_31 = size_t{1} << 31;
+        const size_t two_32 = size_t{1} << 32;
+
+        BOOST_CHECK_EQUAL(two_31, MinMaxTree::GetNumLeavesFor(two_31 - 1, 1));
+        BOOST_CHECK_EQUAL(two_31, MinMaxTree::GetNumLeavesFor(two_31, 1));
+        BOOST_CHECK_EQUAL(two_32, MinMaxTree::GetNumLeavesFor(two_31 + 1, 1));
+        BOOST_CHECK_EQUAL(two_31, MinMaxTree::GetNumLeavesFor(two_32 - 1, 2));
+        BOOST_CHECK_EQUAL(two_31, MinMaxTree::GetNumLeavesFor(two_32, 2));
+        BOOST_CHECK_EQUAL(two_32, MinMaxTree::GetNumLeavesFor(two_32 + 1, 2));
+        BOOST_CHECK_EQUAL(size_t{1} << 36, MinMaxTree::GetNumLeavesFor((size_t{1} << 40) + 1, 32));
+        BOOST_CHECK_EQUAL(size_t{1} << 62, MinMaxTree::GetNumLeavesFor(std::numeric_limits<size_t>::max(), 4));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ResizeReusesStorage)
+{
+    MinMaxTree tree(16);
+    const double* min_values = tree.GetView().GetMinValues();
+
+    tree.ResizeUninitialized(4);
+    BOOST_CHECK_EQUAL(4, tree.GetNumLeaves());
+    BOOST_CHECK_EQUAL(7, tree.GetNumNodes());
+    BOOST_CHECK_EQUAL(16, tree.GetCapacity());
+    BOOST_CHECK_EQUAL(min_values, tree.GetView().GetMinValues());
+
+    const auto leaves = MakeLeaves(4);
+    for (size_t i = 0; i < leaves.size(); ++i) { tree.SetLeaf(i, leaves[i]); }
+    tree.FillInternalNodes();
+    CheckAllLeafIntervals(tree, leaves);
+
+    tree.ResizeUninitialized(32);
+    BOOST_CHECK_EQUAL(32, tree.GetCapacity());
+
+    const auto more_leaves = MakeLeaves(32);
+    for (size_t i = 0; i < more_leaves.size(); ++i) { tree.SetLeaf(i, more_leaves[i]); }
+    tree.FillInternalNodes();
+    CheckAllLeafIntervals(tree, more_leaves);
+
+    MinMaxTree moved(std::move(tree));
+    BOOST_CHECK_EQUAL(0, tree.GetNumLeaves());
+    CheckAllLeafIntervals(moved, more_leaves);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
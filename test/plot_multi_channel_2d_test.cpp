@@ -0,0 +1,132 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_explicit_2d.hpp"
+#include "plot_multi_channel_2d.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <memory>
+
+using plot::ExplicitSingleValueCurve2D;
+using plot::MultiChannelCurve2D;
+using plot::MultiChannelMinMax;
+
+using OptionalValues = std::vector<std::optional<double>>;
+
+static std::shared_ptr<OptionalValues> MakeChannel(size_t num_values, size_t channel)
+{
+    const auto y_values = std::make_shared<OptionalValues>();
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        const bool is_empty = (i + channel) % 6 == 1 || (channel == 2 && i >= 30 && i < 70);
+        y_values->push_back(is_empty ? std::nullopt : std::optional<double>(((i + 7) * (channel + 3) * 31) % 103));
+    }
+
+    return y_values;
+}
+
+static std::optional<std::tuple<double, double>> GetResult(const MultiChannelMinMax& output, size_t idx)
+{
+    if (output.IsEmpty(idx))
+    {
+        return std::nullopt;
+    }
+    else
+    {
+        return std::make_tuple(output.min[idx], output.max[idx]);
+    }
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(MultiChannelCurveTests)
+
+BOOST_AUTO_TEST_CASE(ChannelsMatchSingleCurves)
+{
+    constexpr size_t NUM_VALUES = 200;
+    constexpr size_t NUM_CHANNELS = 5;
+
+    const auto x_values = std::make_shared<std::vector<double>>();
+    for (size_t i = 0; i < NUM_VALUES; ++i) { x_values->push_back(0.3 * i + (i % 3) * 0.05); }
+
+    std::vector<std::shared_ptr<OptionalValues>> channels;
+    std::vector<ExplicitSingleValueCurve2D> expected;
+    for (size_t c = 0; c < NUM_CHANNELS; ++c)
+    {
+        channels.push_back(MakeChannel(NUM_VALUES, c));
+        expected.emplace_back(std::make_shared<std::vector<double>>(*x_values), channels.back());
+    }
+
+    const MultiChannelCurve2D curve(x_values, channels);
+    BOOST_REQUIRE_EQUAL(NUM_CHANNELS, curve.GetNumChannels());
+
+    MultiChannelMinMax output;
+    for (double xmin = -1.1; xmin < 62.0; xmin += 0.45)
+    {
+        for (double width: {0.0, 0.1, 1.2, 7.0, 80.0})
+        {
+            curve.GetMinMaxOverDomainInterval(xmin, xmin + width, output);
+            BOOST_REQUIRE_EQUAL(1, output.num_columns);
+            for (size_t c = 0; c < NUM_CHANNELS; ++c)
+            {
+                BOOST_REQUIRE(expected[c].GetMinMaxOverDomainInterval(xmin, xmin + width) == GetResult(output, c));
+            }
+        }
+    }
+
+    const std::vector<size_t> subset{3, 0};
+    curve.GetMinMaxOverDomainColumns(-2.0, 63.0, 111, subset, output);
+    BOOST_REQUIRE_EQUAL(subset.size() * 111, output.min.size());
+    for (size_t r = 0; r < subset.size(); ++r)
+    {
+        std::vector<std::optional<std::tuple<double, double>>> expected_columns;
+        expected[subset[r]].GetMinMaxOverDomainColumns(-2.0, 63.0, 111, expected_columns);
+        for (size_t i = 0; i < 111; ++i)
+        {
+            BOOST_REQUIRE(expected_columns[i] == GetResult(output, r * 111 + i));
+        }
+    }
+
+    // the same output and working buffers reused for fewer columns of all channels
+    plot::MultiChannelScratch scratch;
+    curve.GetMinMaxOverDomainColumns(-2.0, 63.0, 111, output, &scratch);
+    curve.GetMinMaxOverDomainColumns(5.0, 40.0, 23, output, &scratch);
+    BOOST_REQUIRE_EQUAL(NUM_CHANNELS * 23, output.min.size());
+    for (size_t c = 0; c < NUM_CHANNELS; ++c)
+    {
+        std::vector<std::optional<std::tuple<double, double>>> expected_columns;
+        expected[c].GetMinMaxOverDomainColumns(5.0, 40.0, 23, expected_columns);
+        for (size_t i = 0; i < 23; ++i)
+        {
+            BOOST_REQUIRE(expected_columns[i] == GetResult(output, c * 23 + i));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AppendToAllChannels)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    MultiChannelCurve2D curve(x_values, {std::make_shared<OptionalValues>(), std::make_shared<OptionalValues>()});
+
+    for (int i = 0; i < 40; ++i)
+    {
+        curve.Append(i, {static_cast<double>(i), (i % 2 == 0) ? std::nullopt : std::optional<double>(-i)});
+    }
+
+    MultiChannelMinMax output;
+    curve.GetMinMaxOverDomainInterval(3.0, 10.0, output);
+    BOOST_CHECK(GetResult(output, 0) == std::make_tuple(3.0, 10.0));
+    BOOST_CHECK(GetResult(output, 1) == std::make_tuple(-9.0, -3.0));
+
+    curve.GetMinMaxOverDomainInterval(50.0, 60.0, output);
+    BOOST_CHECK(output.IsEmpty(0) && output.IsEmpty(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
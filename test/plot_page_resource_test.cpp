@@ -0,0 +1,121 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_explicit_2d.hpp"
+#include "plot_page_resource.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using plot::ExplicitSingleValueCurve2D;
+using plot::HugePages;
+using plot::NumaPolicy;
+using plot::PageResource;
+
+static std::shared_ptr<std::vector<double>> MakeXValues(size_t num_values)
+{
+    auto x_values = std::make_shared<std::vector<double>>();
+    for (size_t i = 0; i < num_values; ++i) { x_values->push_back(0.5 * i); }
+
+    return x_values;
+}
+
+static std::shared_ptr<std::vector<std::optional<double>>> MakeYValues(size_t num_values)
+{
+    auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        y_values->push_back(i % 13 == 5 ? std::nullopt : std::optional<double>((i * 71) % 1009));
+    }
+
+    return y_values;
+}
+
+static void CheckSameResults(const ExplicitSingleValueCurve2D& expected, const ExplicitSingleValueCurve2D& actual)
+{
+    const double xmax = expected.GetXValues().back();
+    for (double x1 = -1.0; x1 < xmax; x1 += xmax / 37)
+    {
+        for (double x2 = x1; x2 < xmax + 1.0; x2 += xmax / 29)
+        {
+            BOOST_REQUIRE(expected.GetMinMaxOverDomainInterval(x1, x2) == actual.GetMinMaxOverDomainInterval(x1, x2));
+        }
+    }
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(PageResourceTests)
+
+BOOST_AUTO_TEST_CASE(AllocationsAreUsableAndAligned)
+{
+    for (HugePages huge_pages: {HugePages::None, HugePages::Transparent, HugePages::Explicit})
+    {
+        for (NumaPolicy numa_policy: {NumaPolicy::Default, NumaPolicy::Interleave, NumaPolicy::Bind})
+        {
+            PageResource resource({huge_pages, numa_policy, {}});
+            for (size_t num_bytes: {size_t{1}, size_t{4096}, size_t{3} << 20})
+            {
+                void* ptr = resource.allocate(num_bytes, alignof(std::max_align_t));
+                if (huge_pages != HugePages::None)
+                {
+                    BOOST_CHECK_EQUAL(0, reinterpret_cast<uintptr_t>(ptr) % plot::HUGE_PAGE_SIZE);
+                }
+
+                std::memset(ptr, 0xAB, num_bytes);
+                BOOST_CHECK_EQUAL(0xAB, static_cast<unsigned char*>(ptr)[num_bytes - 1]);
+
+                resource.deallocate(ptr, num_bytes, alignof(std::max_align_t));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CurveWithTreeFromPageResourceMatchesDefault)
+{
+    const size_t NUM_VALUES = 100000;
+    auto x_values = MakeXValues(NUM_VALUES);
+    auto y_values = MakeYValues(NUM_VALUES);
+
+    PageResource resource({HugePages::Transparent, NumaPolicy::Interleave, {}});
+    plot::BuildOptions options;
+    options.memory_resource = &resource;
+
+    const ExplicitSingleValueCurve2D curve(x_values, y_values, options);
+    BOOST_CHECK_EQUAL(&resource, curve.GetTree().GetMemoryResource());
+    CheckSameResults(ExplicitSingleValueCurve2D(x_values, y_values), curve);
+}
+
+BOOST_AUTO_TEST_CASE(ReplicasMatchSingleCurve)
+{
+    const auto nodes = plot::GetNumaNodes();
+    BOOST_REQUIRE(!nodes.empty());
+
+    const size_t NUM_VALUES = 20000;
+    auto x_values = MakeXValues(NUM_VALUES);
+    auto y_values = MakeYValues(NUM_VALUES);
+
+    plot::NumaReplicated<ExplicitSingleValueCurve2D> replicated(
+        [&](const plot::BuildOptions& options) { return ExplicitSingleValueCurve2D(x_values, y_values, options); }
+    );
+    BOOST_REQUIRE_EQUAL(nodes.size(), replicated.GetNumReplicas());
+
+    const ExplicitSingleValueCurve2D expected(x_values, y_values);
+    CheckSameResults(expected, replicated.Get());
+    for (size_t i = 0; i < replicated.GetNumReplicas(); ++i)
+    {
+        CheckSameResults(expected, replicated.GetReplica(i));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_explicit_2d.hpp"
+#include "plot_ring_buffer_2d.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <memory>
+
+using plot::ExplicitSingleValueCurve2D;
+using plot::RingBufferCurve2D;
+
+static std::optional<double> GetYValue(size_t i)
+{
+    return (i % 8 == 5 || (i >= 200 && i < 230)) ? std::nullopt : std::optional<double>((i * 59) % 113);
+}
+
+/// Checks that `curve` gives the same results as an explicit curve of its values.
+static void CheckSameAsExplicit(const RingBufferCurve2D& curve)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (size_t i = 0; i < curve.GetNumValues(); ++i)
+    {
+        x_values->push_back(curve.GetX(i));
+        y_values->push_back(curve.GetY(i));
+    }
+    const ExplicitSingleValueCurve2D expected(x_values, y_values);
+
+    const double x_begin = x_values->empty() ? 0.0 : x_values->front() - 2.0;
+    const double x_end = x_values->empty() ? 0.0 : x_values->back() + 2.0;
+
+    for (double xmin = x_begin; xmin < x_end; xmin += 1.7)
+    {
+        for (double width: {0.0, 0.5, 3.0, 20.0, 500.0})
+        {
+            BOOST_REQUIRE(expected.GetMinMaxOverDomainInterval(xmin, xmin + width) ==
+                          curve.GetMinMaxOverDomainInterval(xmin, xmin + width));
+        }
+    }
+
+    std::vector<std::optional<std::tuple<double, double>>> expected_columns, actual_columns;
+    expected.GetMinMaxOverDomainColumns(x_begin, x_end, 41, expected_columns);
+    curve.GetMinMaxOverDomainColumns(x_begin, x_end, 41, actual_columns);
+    BOOST_CHECK(expected_columns == actual_columns);
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(RingBufferCurveTests)
+
+BOOST_AUTO_TEST_CASE(LiveWindowMatchesExplicitCurve)
+{
+    for (size_t capacity: {1, 2, 7, 64, 100})
+    {
+        for (size_t leaf_size: {1, 4})
+        {
+            plot::BuildOptions options;
+            options.leaf_size = leaf_size;
+            RingBufferCurve2D curve(capacity, options);
+            BOOST_CHECK(!curve.GetMinMaxOverDomainInterval(-1.0, 1.0).has_value());
+
+            for (size_t i = 0; i < 350; ++i)
+            {
+                curve.Append(0.75 * i, GetYValue(i));
+                BOOST_REQUIRE_EQUAL(std::min(i + 1, capacity), curve.GetNumValues());
+
+                if (i % 23 == 0 || i < 2 * capacity) { CheckSameAsExplicit(curve); }
+            }
+
+            // the oldest values have been overwritten
+            BOOST_CHECK_EQUAL(0.75 * (350 - capacity), curve.GetX(0));
+            BOOST_CHECK(!curve.GetMinMaxOverDomainInterval(0.0, 0.75 * (349 - capacity)).has_value());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
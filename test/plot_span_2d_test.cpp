@@ -0,0 +1,113 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_explicit_2d.hpp"
+#include "plot_span_2d.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+using plot::ExplicitSingleValueCurve2D;
+using plot::SpanExplicitSingleValueCurve2D;
+
+/// Values of a curve in the caller-owned layout, and the equivalent `ExplicitSingleValueCurve2D`.
+struct SpanData
+{
+    std::vector<double> x_values;
+    std::vector<double> y_values;   ///< NaN where missing
+    std::vector<uint8_t> validity;
+    std::shared_ptr<std::vector<std::optional<double>>> optional_y_values;
+
+    explicit SpanData(size_t num_values)
+    : validity((num_values + 7) / 8, 0), optional_y_values(std::make_shared<std::vector<std::optional<double>>>())
+    {
+        for (size_t i = 0; i < num_values; ++i)
+        {
+            x_values.push_back(-1.0 + 0.25 * i);
+
+            const bool is_valid = !(i % 5 == 2 || (i >= 60 && i < 90));
+            y_values.push_back(is_valid ? static_cast<double>((i * 29) % 83) : std::numeric_limits<double>::quiet_NaN());
+            if (is_valid) { validity[i / 8] |= 1 << (i % 8); }
+            optional_y_values->push_back(is_valid ? std::optional<double>(y_values.back()) : std::nullopt);
+        }
+    }
+
+    ExplicitSingleValueCurve2D MakeExplicitCurve() const
+    {
+        return ExplicitSingleValueCurve2D(std::make_shared<std::vector<double>>(x_values), optional_y_values);
+    }
+};
+
+static void CheckSameResults(const ExplicitSingleValueCurve2D& expected, const SpanExplicitSingleValueCurve2D& curve)
+{
+    for (double xmin = -3.1; xmin < 80.0; xmin += 0.7)
+    {
+        for (double width: {0.0, 0.1, 0.25, 1.3, 9.0, 100.0})
+        {
+            BOOST_REQUIRE(expected.GetMinMaxOverDomainInterval(xmin, xmin + width) ==
+                          curve.GetMinMaxOverDomainInterval(xmin, xmin + width));
+        }
+    }
+
+    std::vector<std::optional<std::tuple<double, double>>> expected_columns, actual_columns;
+    expected.GetMinMaxOverDomainColumns(-2.0, 80.0, 173, expected_columns);
+    curve.GetMinMaxOverDomainColumns(-2.0, 80.0, 173, actual_columns);
+    BOOST_CHECK(expected_columns == actual_columns);
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(SpanCurveTests)
+
+BOOST_AUTO_TEST_CASE(ValidityBitmap)
+{
+    for (size_t num_values: {1, 2, 9, 300})
+    {
+        const SpanData data(num_values);
+        for (size_t leaf_size: {1, 2, 8})
+        {
+            plot::BuildOptions options;
+            options.leaf_size = leaf_size;
+
+            // NaNs are ignored in this mode: they are all masked by the bitmap anyway
+            const SpanExplicitSingleValueCurve2D curve(
+                data.x_values.data(), data.y_values.data(), num_values, data.validity.data(), options
+            );
+            CheckSameResults(data.MakeExplicitCurve(), curve);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(NaNAsMissing)
+{
+    for (size_t num_values: {1, 2, 9, 300})
+    {
+        const SpanData data(num_values);
+        for (size_t leaf_size: {1, 2, 8})
+        {
+            plot::BuildOptions options;
+            options.leaf_size = leaf_size;
+
+            const SpanExplicitSingleValueCurve2D curve(data.x_values.data(), data.y_values.data(), num_values, nullptr, options);
+            CheckSameResults(data.MakeExplicitCurve(), curve);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(EmptySpan)
+{
+    const SpanExplicitSingleValueCurve2D curve(nullptr, nullptr, 0);
+    BOOST_CHECK(!curve.GetMinMaxOverDomainInterval(-1.0, 1.0).has_value());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,163 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_explicit_2d.hpp"
+#include "plot_sparse_2d.hpp"
+
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+
+using plot::ExplicitSingleValueCurve2D;
+using plot::SparseExplicitSingleValueCurve2D;
+
+/// Timeline with gaps of various lengths (including at both ends and single empty values).
+static void MakeTimeline(std::vector<double>& x_values, std::vector<std::optional<double>>& y_values)
+{
+    std::mt19937 generator(11);
+    x_values.clear();
+    y_values.clear();
+
+    double x = -5.0;
+    for (int run = 0; run < 60; ++run)
+    {
+        const size_t gap_length = run % 5 == 0 ? 1 : generator() % 3000;
+        const size_t run_length = run % 7 == 0 ? 1 : generator() % 50 + 1;
+
+        for (size_t i = 0; i < gap_length; ++i)
+        {
+            x_values.push_back(x += 0.5);
+            y_values.push_back(std::nullopt);
+        }
+        for (size_t i = 0; i < run_length; ++i)
+        {
+            x_values.push_back(x += 0.5);
+            y_values.push_back(static_cast<double>(generator() % 1000));
+        }
+    }
+    for (size_t i = 0; i < 100; ++i)
+    {
+        x_values.push_back(x += 0.5);
+        y_values.push_back(std::nullopt);
+    }
+}
+
+static void CheckSameAs(const SparseExplicitSingleValueCurve2D& curve, const ExplicitSingleValueCurve2D& reference)
+{
+    const auto& x_values = reference.GetXValues();
+    BOOST_REQUIRE_EQUAL(x_values.size(), curve.GetNumValues());
+
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> distribution(x_values.front() - 1.0, x_values.back() + 1.0);
+    std::uniform_real_distribution<double> width(0.0, 30.0);
+    for (int i = 0; i < 3000; ++i)
+    {
+        // narrow intervals, so that their bounds often fall into gaps or next to them
+        const double x1 = distribution(generator);
+        const double x2 = x1 + width(generator);
+
+        BOOST_REQUIRE(reference.GetMinMaxOverDomainInterval(x1, x2) == curve.GetMinMaxOverDomainInterval(x1, x2));
+    }
+
+    // interval bounds at the X values, which are either stored or inside gaps
+    for (size_t i = 0; i + 3 < x_values.size(); i += 7)
+    {
+        BOOST_REQUIRE(reference.GetMinMaxOverDomainInterval(x_values[i], x_values[i + 3])
+            == curve.GetMinMaxOverDomainInterval(x_values[i], x_values[i + 3]));
+    }
+
+    std::vector<std::optional<std::tuple<double, double>>> expected, actual;
+    reference.GetMinMaxOverDomainColumns(x_values.front(), x_values.back(), 997, expected);
+    curve.GetMinMaxOverDomainColumns(x_values.front(), x_values.back(), 997, actual);
+    BOOST_REQUIRE(expected == actual);
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(SparseCurveTests)
+
+BOOST_AUTO_TEST_CASE(ResultsMatchFullTimeline)
+{
+    std::vector<double> x_values;
+    std::vector<std::optional<double>> y_values;
+    MakeTimeline(x_values, y_values);
+
+    const SparseExplicitSingleValueCurve2D curve(x_values, y_values);
+    CheckSameAs(
+        curve,
+        ExplicitSingleValueCurve2D(
+            std::make_shared<std::vector<double>>(x_values),
+            std::make_shared<std::vector<std::optional<double>>>(y_values)
+        )
+    );
+
+    size_t num_non_empty = 0;
+    for (const auto& y: y_values) { num_non_empty += y.has_value() ? 1 : 0; }
+
+    BOOST_CHECK_EQUAL(60, curve.GetRuns().size());
+    BOOST_CHECK_EQUAL(num_non_empty, curve.GetNumStoredValues());
+    BOOST_CHECK_LT(curve.GetNumStoredValues() * 10, x_values.size());
+
+    // each run is preceded and followed by an empty value of the timeline
+    const auto& stored_x = curve.GetStoredXValues();
+    size_t num_in_runs = 0;
+    for (const auto& run: curve.GetRuns())
+    {
+        const size_t first = std::lower_bound(x_values.begin(), x_values.end(), stored_x[run.first_idx]) - x_values.begin();
+        const size_t last = std::lower_bound(x_values.begin(), x_values.end(), stored_x[run.end_idx - 1]) - x_values.begin();
+
+        BOOST_REQUIRE_EQUAL(run.end_idx - run.first_idx, last + 1 - first);
+        BOOST_REQUIRE(!y_values[first - 1].has_value());
+        BOOST_REQUIRE(!y_values[last + 1].has_value());
+        num_in_runs += run.end_idx - run.first_idx;
+    }
+    BOOST_CHECK_EQUAL(num_non_empty, num_in_runs);
+}
+
+BOOST_AUTO_TEST_CASE(AppendedTimelineMatchesConstructed)
+{
+    std::vector<double> x_values;
+    std::vector<std::optional<double>> y_values;
+    MakeTimeline(x_values, y_values);
+
+    const size_t NUM_INITIAL = 5000;
+    SparseExplicitSingleValueCurve2D curve(
+        std::vector<double>(x_values.begin(), x_values.begin() + NUM_INITIAL),
+        std::vector<std::optional<double>>(y_values.begin(), y_values.begin() + NUM_INITIAL)
+    );
+    for (size_t i = NUM_INITIAL; i < x_values.size(); ++i) { curve.Append(x_values[i], y_values[i]); }
+
+    CheckSameAs(
+        curve,
+        ExplicitSingleValueCurve2D(
+            std::make_shared<std::vector<double>>(x_values),
+            std::make_shared<std::vector<std::optional<double>>>(y_values)
+        )
+    );
+
+    const SparseExplicitSingleValueCurve2D constructed(x_values, y_values);
+    BOOST_CHECK(constructed.GetStoredXValues() == curve.GetStoredXValues());
+    BOOST_CHECK(constructed.GetStoredYValues() == curve.GetStoredYValues());
+    BOOST_REQUIRE_EQUAL(constructed.GetRuns().size(), curve.GetRuns().size());
+    for (size_t i = 0; i < curve.GetRuns().size(); ++i)
+    {
+        BOOST_REQUIRE_EQUAL(constructed.GetRuns()[i].first_idx, curve.GetRuns()[i].first_idx);
+        BOOST_REQUIRE_EQUAL(constructed.GetRuns()[i].end_idx, curve.GetRuns()[i].end_idx);
+    }
+
+    SparseExplicitSingleValueCurve2D empty({}, {});
+    for (size_t i = 0; i < x_values.size(); ++i) { empty.Append(x_values[i], y_values[i]); }
+    BOOST_CHECK(constructed.GetStoredXValues() == empty.GetStoredXValues());
+    BOOST_CHECK_EQUAL(x_values.size(), empty.GetNumValues());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,111 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_explicit_2d.hpp"
+#include "plot_stats.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <thread>
+
+using plot::ExplicitSingleValueCurve2D;
+
+static ExplicitSingleValueCurve2D MakeCurve(size_t num_values, size_t leaf_size, bool lazy = false)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        x_values->push_back(i);
+        y_values->push_back((i * 37) % 101);
+    }
+
+    plot::BuildOptions options;
+    options.leaf_size = leaf_size;
+    options.lazy = lazy;
+
+    return ExplicitSingleValueCurve2D(x_values, y_values, options);
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(StatsTests)
+
+BOOST_AUTO_TEST_CASE(BuildIsCounted)
+{
+    plot::ResetStats();
+    const auto curve = MakeCurve(1000, 4);
+
+    const plot::Stats& stats = plot::GetStats();
+    BOOST_CHECK_EQUAL(1, stats.num_builds);
+    BOOST_CHECK_EQUAL(2 * curve.GetTree().GetNumNodes() * sizeof(double), stats.build_bytes);
+    BOOST_CHECK_EQUAL(0, stats.num_queries);
+}
+
+BOOST_AUTO_TEST_CASE(LazyBuildIsDeferred)
+{
+    plot::ResetStats();
+
+    const auto curve = MakeCurve(100, 2, true);
+    BOOST_CHECK_EQUAL(0, plot::GetStats().num_builds);
+
+    curve.EnsureBuilt();
+    curve.EnsureBuilt();
+    BOOST_CHECK_EQUAL(1, plot::GetStats().num_builds);
+}
+
+BOOST_AUTO_TEST_CASE(IntervalQueryIsCounted)
+{
+    const auto curve = MakeCurve(1000, 4);
+    plot::ResetStats();
+
+    // values [11, 900] and interpolated values at both ends; leaves [3, 224] are read from the tree,
+    // values 11 and 900 are scanned
+    const auto result = curve.GetMinMaxOverDomainInterval(10.5, 900.5);
+    BOOST_REQUIRE(result.has_value());
+
+    const plot::Stats& stats = plot::GetStats();
+    BOOST_CHECK_EQUAL(1, stats.num_queries);
+    BOOST_CHECK_EQUAL(2, stats.num_interpolations);
+    BOOST_CHECK_EQUAL(2, stats.num_leaf_scans);
+    BOOST_CHECK_EQUAL(2, stats.num_values_scanned);
+    BOOST_CHECK_GT(stats.num_nodes_visited, 0);
+    BOOST_CHECK_LE(stats.num_nodes_visited, 2 * 8);
+    BOOST_CHECK_GT(stats.num_search_steps, 0);
+    BOOST_CHECK_EQUAL(0, stats.num_builds);
+
+    plot::ResetStats();
+    BOOST_CHECK_EQUAL(0, plot::GetStats().num_queries);
+    BOOST_CHECK_EQUAL(0, plot::GetStats().num_nodes_visited);
+}
+
+BOOST_AUTO_TEST_CASE(ColumnQueryCountsEachColumn)
+{
+    const auto curve = MakeCurve(1000, 4);
+    plot::ResetStats();
+
+    std::vector<std::optional<std::tuple<double, double>>> output;
+    curve.GetMinMaxOverDomainColumns(0.0, 999.0, 37, output);
+
+    BOOST_CHECK_EQUAL(37, plot::GetStats().num_queries);
+}
+
+BOOST_AUTO_TEST_CASE(StatsArePerThread)
+{
+    const auto curve = MakeCurve(1000, 4);
+    plot::ResetStats();
+
+    std::thread([&] { curve.GetMinMaxOverDomainInterval(1.0, 500.0); }).join();
+
+    BOOST_CHECK_EQUAL(0, plot::GetStats().num_queries);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,12 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Plot
+
+#include <boost/test/unit_test.hpp>
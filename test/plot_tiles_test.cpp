@@ -0,0 +1,138 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_explicit_2d.hpp"
+#include "plot_tiles.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using plot::ExplicitSingleValueCurve2D;
+using plot::Tile;
+using plot::TileGrid;
+
+static ExplicitSingleValueCurve2D MakeCurve(size_t num_values)
+{
+    auto x_values = std::make_shared<std::vector<double>>();
+    auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        x_values->push_back(0.3 * i);
+        y_values->push_back(i % 17 == 2 || (i >= 300 && i < 400) ? std::nullopt : std::optional<double>((i * 43) % 211));
+    }
+
+    return ExplicitSingleValueCurve2D(x_values, y_values);
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(TileTests)
+
+BOOST_AUTO_TEST_CASE(TilesMatchIntervalQueries)
+{
+    const auto curve = MakeCurve(2000);
+    const TileGrid grid{-10.0, 160.0, 16};
+
+    for (int32_t zoom: {-1, 0, 3})
+    {
+        std::vector<Tile> tiles;
+        plot::GetTiles(curve, 5, 0, grid, zoom, -2, 12, tiles);
+        BOOST_REQUIRE_EQUAL(12, tiles.size());
+
+        for (size_t i = 0; i < tiles.size(); ++i)
+        {
+            const int64_t tile_idx = -2 + static_cast<int64_t>(i);
+            BOOST_REQUIRE(tiles[i].key == (plot::TileKey{5, 0, grid, zoom, tile_idx}));
+            BOOST_REQUIRE_EQUAL(grid.num_columns, tiles[i].columns.size());
+
+            for (size_t column = 0; column < grid.num_columns; ++column)
+            {
+                const auto expected = curve.GetMinMaxOverDomainInterval(
+                    grid.GetColumnEdge(zoom, tile_idx, column),
+                    grid.GetColumnEdge(zoom, tile_idx, column + 1)
+                );
+                BOOST_REQUIRE(expected == tiles[i].columns[column]);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TilesDoNotDependOnBatch)
+{
+    const auto curve = MakeCurve(1000);
+    const TileGrid grid{0.0, 37.5, 10};
+
+    std::vector<Tile> batch;
+    plot::GetTiles(curve, 1, 0, grid, 2, 0, 30, batch);
+
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        std::vector<Tile> single;
+        plot::GetTiles(curve, 1, 0, grid, 2, static_cast<int64_t>(i), 1, single);
+        BOOST_REQUIRE(batch[i].key == single[0].key);
+        BOOST_REQUIRE(batch[i].columns == single[0].columns);
+    }
+
+    // adjacent tiles share their edge
+    BOOST_CHECK_EQUAL(grid.GetColumnEdge(2, 4, grid.num_columns), grid.GetColumnEdge(2, 5, 0));
+}
+
+BOOST_AUTO_TEST_CASE(KeyChangesWithRevisionAndGrid)
+{
+    auto curve = MakeCurve(100);
+    const TileGrid grid{0.0, 10.0, 4};
+
+    std::vector<Tile> before, after;
+    plot::GetTiles(curve, 9, 1, grid, 0, 1, 1, before);
+    curve.SetValue(40, 1000.0);
+    plot::GetTiles(curve, 9, 2, grid, 0, 1, 1, after);
+
+    BOOST_CHECK(before[0].key != after[0].key);
+    BOOST_CHECK(before[0].key.ToString() != after[0].key.ToString());
+    BOOST_CHECK(std::get<1>(*after[0].columns[0]) == 1000.0);
+
+    // the same tile position in other grids has other contents
+    for (const TileGrid& other_grid: {TileGrid{0.5, 10.0, 4}, TileGrid{0.0, 10.0 + 1.0e-9, 4}, TileGrid{0.0, 10.0, 8}})
+    {
+        std::vector<Tile> other;
+        plot::GetTiles(curve, 9, 2, other_grid, 0, 1, 1, other);
+        BOOST_CHECK(other[0].key != after[0].key);
+        BOOST_CHECK(other[0].key.ToString() != after[0].key.ToString());
+    }
+
+    BOOST_CHECK_EQUAL("9/2/0x0p+0,0x1.4p+3,4/0/1", after[0].key.ToString());
+}
+
+BOOST_AUTO_TEST_CASE(SerializedTileIsRestored)
+{
+    const auto curve = MakeCurve(2000);
+    std::vector<Tile> tiles;
+    plot::GetTiles(curve, 3, 12, TileGrid{0.0, 100.0, 50}, 0, 0, 10, tiles);
+
+    for (const auto& tile: tiles)
+    {
+        const auto data = plot::SerializeTile(tile);
+        const Tile restored = plot::DeserializeTile(data.data(), data.size());
+        BOOST_REQUIRE(tile.key == restored.key);
+        BOOST_REQUIRE(tile.columns == restored.columns);
+
+        BOOST_CHECK_THROW(plot::DeserializeTile(data.data(), data.size() - 1), std::runtime_error);
+    }
+
+    // tile 0 spans [0, 100]; its columns from X = 90 on (values 300...333) are empty and take 1 bit each
+    size_t num_empty = 0;
+    for (const auto& column: tiles[0].columns) { num_empty += column.has_value() ? 0 : 1; }
+    BOOST_CHECK_EQUAL(5, num_empty);
+    BOOST_CHECK_EQUAL(52 + 7 + 45 * 2 * sizeof(double), plot::SerializeTile(tiles[0]).size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
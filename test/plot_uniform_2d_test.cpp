@@ -0,0 +1,126 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_explicit_2d.hpp"
+#include "plot_uniform_2d.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <memory>
+
+using plot::ExplicitSingleValueCurve2D;
+using plot::UniformExplicitSingleValueCurve2D;
+
+static std::shared_ptr<std::vector<std::optional<double>>> MakeYValues(size_t num_values)
+{
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        y_values->push_back((i % 7 == 3 || (i >= 40 && i < 55)) ? std::nullopt : std::optional<double>((i * 37) % 97));
+    }
+
+    return y_values;
+}
+
+/// Returns a curve with explicitly stored X values equal to the X values of `curve`.
+static ExplicitSingleValueCurve2D MakeExplicitCurve(const UniformExplicitSingleValueCurve2D& curve)
+{
+    const auto x_values = std::make_shared<std::vector<double>>();
+    for (size_t i = 0; i < curve.GetYValues().size(); ++i)
+    {
+        x_values->push_back(curve.GetX(i));
+    }
+
+    return ExplicitSingleValueCurve2D(x_values, std::make_shared<std::vector<std::optional<double>>>(curve.GetYValues()));
+}
+
+static void CheckSameAsExplicit(const UniformExplicitSingleValueCurve2D& curve)
+{
+    const ExplicitSingleValueCurve2D expected = MakeExplicitCurve(curve);
+    const size_t num_values = curve.GetYValues().size();
+
+    const double x_begin = curve.GetX0() - 3.7 * curve.GetDX();
+    const double x_end = curve.GetX(num_values) + 3.7 * curve.GetDX();
+
+    for (double xmin = x_begin; xmin < x_end; xmin += 0.73 * curve.GetDX())
+    {
+        for (double width: {0.0, 0.2, 1.0, 4.5, 30.0, 1000.0})
+        {
+            const double xmax = xmin + width * curve.GetDX();
+            BOOST_REQUIRE(expected.GetMinMaxOverDomainInterval(xmin, xmax) == curve.GetMinMaxOverDomainInterval(xmin, xmax));
+        }
+    }
+
+    // intervals starting and ending exactly at the X values
+    for (size_t i = 0; i < num_values; i += 3)
+    {
+        for (size_t j = i; j < num_values; j += 11)
+        {
+            BOOST_REQUIRE(expected.GetMinMaxOverDomainInterval(curve.GetX(i), curve.GetX(j)) ==
+                          curve.GetMinMaxOverDomainInterval(curve.GetX(i), curve.GetX(j)));
+        }
+    }
+
+    std::vector<std::optional<std::tuple<double, double>>> expected_columns, actual_columns;
+    expected.GetMinMaxOverDomainColumns(x_begin, x_end, 217, expected_columns);
+    curve.GetMinMaxOverDomainColumns(x_begin, x_end, 217, actual_columns);
+    BOOST_CHECK(expected_columns == actual_columns);
+
+    std::vector<double> edges;
+    for (size_t i = 0; i <= num_values; i += 5) { edges.push_back(curve.GetX(i)); }
+    expected.GetMinMaxOverDomainColumns(edges, expected_columns);
+    curve.GetMinMaxOverDomainColumns(edges, actual_columns);
+    BOOST_CHECK(expected_columns == actual_columns);
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(UniformCurveTests)
+
+BOOST_AUTO_TEST_CASE(MatchesExplicitCurve)
+{
+    // 0.1 is not exactly representable, so the computed indices need correcting to agree with `GetX()`
+    for (const auto& [x0, dx]: {std::make_tuple(0.0, 1.0), std::make_tuple(-2.5, 0.1), std::make_tuple(1.0e6, 0.3)})
+    {
+        for (size_t num_values: {1, 2, 3, 100, 257})
+        {
+            CheckSameAsExplicit(UniformExplicitSingleValueCurve2D(x0, dx, MakeYValues(num_values)));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(EmptyCurve)
+{
+    const UniformExplicitSingleValueCurve2D curve(0.0, 1.0, MakeYValues(0));
+    BOOST_CHECK(!curve.GetMinMaxOverDomainInterval(-10.0, 10.0).has_value());
+
+    std::vector<std::optional<std::tuple<double, double>>> columns;
+    curve.GetMinMaxOverDomainColumns(-10.0, 10.0, 4, columns);
+    BOOST_CHECK(columns == decltype(columns)(4));
+}
+
+BOOST_AUTO_TEST_CASE(AppendMatchesConstruction)
+{
+    const auto all_values = MakeYValues(300);
+
+    plot::BuildOptions options;
+    options.leaf_size = 4;
+
+    UniformExplicitSingleValueCurve2D curve(0.5, 0.25, std::make_shared<std::vector<std::optional<double>>>(), options);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        curve.Append((*all_values)[i]);
+    }
+    curve.AppendBatch(std::vector<std::optional<double>>(all_values->begin() + 100, all_values->end()));
+
+    BOOST_CHECK(curve.GetYValues() == *all_values);
+    CheckSameAsExplicit(curve);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
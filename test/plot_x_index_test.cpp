@@ -0,0 +1,134 @@
+//
+// Plot
+// Copyright (c) 2019 Filip Szczerek <ga.software@yahoo.com>
+//
+// This project is licensed under the terms of the MIT license
+// (see the LICENSE file for details).
+//
+
+#define BOOST_TEST_DYN_LINK
+
+#include "plot_explicit_2d.hpp"
+#include "plot_span_2d.hpp"
+#include "plot_x_index.hpp"
+
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using plot::ExplicitSingleValueCurve2D;
+using plot::XIndex;
+
+static std::vector<double> MakeXValues(size_t num_values)
+{
+    std::vector<double> x_values;
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        x_values.push_back(1.5 * i + (i % 3) * 0.25);
+    }
+
+    return x_values;
+}
+
+// ---------------------------- Test cases -------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(XIndexTests)
+
+BOOST_AUTO_TEST_CASE(SearchStartPrecedesLowerBound)
+{
+    for (size_t num_values: {0, 1, 2, 15, 16, 17, 33, 48, 49, 100, 113, 1000, 4097})
+    {
+        const std::vector<double> x_values = MakeXValues(num_values);
+        const XIndex index(x_values.data(), x_values.size());
+        BOOST_REQUIRE_EQUAL(num_values, index.GetNumValues());
+
+        for (double x = -2.0; x < 1.5 * num_values + 3.0; x += 0.125)
+        {
+            const size_t expected = std::lower_bound(x_values.begin(), x_values.end(), x) - x_values.begin();
+            const size_t start = index.GetSearchStart(x);
+
+            BOOST_REQUIRE_LE(start, expected);
+            if (expected < num_values)
+            {
+                BOOST_REQUIRE_LE(expected - start, XIndex::SAMPLE_STRIDE);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(IndexedCurveMatchesUnindexed)
+{
+    const auto x_values = std::make_shared<std::vector<double>>(MakeXValues(5000));
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (size_t i = 0; i < x_values->size(); ++i)
+    {
+        y_values->push_back(i % 13 == 4 ? std::nullopt : std::optional<double>((i * 71) % 103));
+    }
+
+    plot::BuildOptions options;
+    options.build_x_index = true;
+
+    const ExplicitSingleValueCurve2D plain(x_values, y_values);
+    ExplicitSingleValueCurve2D indexed(
+        std::make_shared<std::vector<double>>(*x_values),
+        std::make_shared<std::vector<std::optional<double>>>(*y_values),
+        options
+    );
+
+    std::vector<double> span_y_values;
+    for (const auto& y: *y_values) { span_y_values.push_back(y.value_or(std::numeric_limits<double>::quiet_NaN())); }
+    const plot::SpanExplicitSingleValueCurve2D span(x_values->data(), span_y_values.data(), x_values->size(), nullptr, options);
+
+    for (double xmin = -3.0; xmin < 7600.0; xmin += 17.3)
+    {
+        for (double width: {0.1, 2.0, 40.0, 3000.0})
+        {
+            const auto expected = plain.GetMinMaxOverDomainInterval(xmin, xmin + width);
+            BOOST_REQUIRE(expected == indexed.GetMinMaxOverDomainInterval(xmin, xmin + width));
+            BOOST_REQUIRE(expected == span.GetMinMaxOverDomainInterval(xmin, xmin + width));
+        }
+    }
+
+    // values appended after building the index are found as well
+    for (int i = 0; i < 100; ++i) { indexed.Append(8000.0 + i, 500.0 + i); }
+    BOOST_CHECK(indexed.GetMinMaxOverDomainInterval(8050.0, 9000.0) == std::make_tuple(550.0, 599.0));
+    BOOST_CHECK(indexed.GetMinMaxOverDomainInterval(8010.0, 8010.5) == std::make_tuple(510.0, 510.5));
+}
+
+BOOST_AUTO_TEST_CASE(HintedQueriesMatchUnhinted)
+{
+    const auto x_values = std::make_shared<std::vector<double>>(MakeXValues(2000));
+    const auto y_values = std::make_shared<std::vector<std::optional<double>>>();
+    for (size_t i = 0; i < x_values->size(); ++i)
+    {
+        y_values->push_back(i % 7 == 1 ? std::nullopt : std::optional<double>((i * 37) % 59));
+    }
+
+    const ExplicitSingleValueCurve2D curve(x_values, y_values);
+    const plot::SpanExplicitSingleValueCurve2D empty_span(nullptr, nullptr, 0);
+
+    // pans right, then jumps back and pans left
+    plot::SearchHint hint;
+    std::vector<double> starts;
+    for (double xmin = -5.0; xmin < 3100.0; xmin += 3.7) { starts.push_back(xmin); }
+    for (double xmin = 3050.0; xmin > -10.0; xmin -= 11.1) { starts.push_back(xmin); }
+    starts.push_back(1000.0);
+    starts.push_back(1000.0);
+
+    for (double xmin: starts)
+    {
+        for (double width: {0.3, 25.0})
+        {
+            BOOST_REQUIRE(curve.GetMinMaxOverDomainInterval(xmin, xmin + width) ==
+                          curve.GetMinMaxOverDomainInterval(xmin, xmin + width, hint));
+        }
+    }
+
+    plot::SearchHint out_of_range{1'000'000};
+    BOOST_CHECK(curve.GetMinMaxOverDomainInterval(10.0, 20.0) == curve.GetMinMaxOverDomainInterval(10.0, 20.0, out_of_range));
+    BOOST_CHECK(!empty_span.GetMinMaxOverDomainInterval(10.0, 20.0, out_of_range).has_value());
+}
+
+BOOST_AUTO_TEST_SUITE_END()